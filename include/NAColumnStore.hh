@@ -0,0 +1,56 @@
+// Columnar time-series storage for NATrajectory
+#ifndef NAColumnStore_h
+#define NAColumnStore_h 1
+
+#include "globals.hh"
+
+// us
+#include "QTStorePool.hh"
+
+// std
+#include <array>
+#include <vector>
+
+/// Column store for the Signal ntuple time series.
+///
+/// One store per trajectory, taken from the thread-local QTStorePool on
+/// construction and handed back on destruction. Tracks reuse the memory
+/// of previous tracks and a step append is a single capacity check plus
+/// stores.
+/// The output manager swaps the column vectors into its booked ntuple
+/// columns, i.e. no element copy on writing a row.
+
+class NAColumnStore
+{
+public:
+  // column order as booked in NAOutputManager Signal ntuple
+  enum Column { kOm = 0, kKE, kTime, kPosx, kPosy, kPosz,
+		kBetax, kBetay, kBetaz, kAccx, kAccy, kAccz,
+		kNColumns };
+  using Row = std::array<G4double, kNColumns>;
+
+  inline void Append(const Row& row);
+  void        Clear();
+
+  inline std::size_t            Size() const      { return fColumns[0].size(); }
+  inline std::vector<G4double>& GetColumn(G4int c) { return fColumns[c]; }
+
+private:
+  friend class QTStorePool<NAColumnStore>;
+  NAColumnStore() = default;
+  void Grow(); // reserve all columns at once
+
+  std::array<std::vector<G4double>, kNColumns> fColumns;
+  std::size_t fCapacity = 0; // smallest column capacity
+
+  static constexpr std::size_t fInitialRows = 64; // doubled on demand, most tracks are short
+};
+
+inline void NAColumnStore::Append(const Row& row)
+{
+  // single growth decision for all columns, no reallocation in push_back
+  if (fColumns[0].size() == fCapacity) Grow();
+  for (G4int c = 0; c < kNColumns; ++c) fColumns[c].push_back(row[c]);
+}
+
+#endif
@@ -6,9 +6,12 @@
 #include "G4UserEventAction.hh"
 #include "globals.hh"
 
+#include <chrono>
+
 /// Event action class
 ///
 class NAOutputManager;
+class QTEventTrigger;
 
 
 class NAEventAction : public G4UserEventAction
@@ -28,8 +31,11 @@ private:
   // data members
   // hit data
   NAOutputManager*      fOutput  = nullptr;
+  QTEventTrigger*       fTrigger = nullptr;
   G4int                 fGID     = -1;
   G4int                 fVID     = -1;
+  // event wall time, see QTEventCost
+  std::chrono::steady_clock::time_point fStart;
 
 };
 
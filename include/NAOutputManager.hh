@@ -3,10 +3,18 @@
 #define NAHistoManager_h 1
 
 #include "G4AnalysisManager.hh"
+#include "G4SystemOfUnits.hh"
 #include "globals.hh"
 
+// us
+#include "NAColumnStore.hh"
+
+#include <array>
 #include <vector>
 
+class QTGasHit;
+class QTHdf5Manager;
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 class NAOutputManager
@@ -21,53 +29,36 @@ public:
   
   void FillNtupleI(G4int which, G4int col, G4int val);
   void FillNtupleD(G4int which, G4int col, G4double val);
-  inline void FillOmVec(G4double val)      { ovec.push_back(val); }
-  inline void FillKEVec(G4double val)      { kvec.push_back(val); }
-  inline void FillTimeVec(G4double val)    { tvec.push_back(val); }
-  inline void FillXVec(G4double val)       { xvec.push_back(val); }
-  inline void FillYVec(G4double val)       { yvec.push_back(val); }
-  inline void FillZVec(G4double val)       { zvec.push_back(val); }
-  inline void FillBetaXVec(G4double val)   { bxvec.push_back(val); }
-  inline void FillBetaYVec(G4double val)   { byvec.push_back(val); }
-  inline void FillBetaZVec(G4double val)   { bzvec.push_back(val); }
-  inline void FillAccXVec(G4double val)    { axvec.push_back(val); }
-  inline void FillAccYVec(G4double val)    { ayvec.push_back(val); }
-  inline void FillAccZVec(G4double val)    { azvec.push_back(val); }
+  void AddScoreRow(G4int eventID, G4double weight, const QTGasHit* hit);  // gas interaction
+  void AddStopRow(G4int eventID, G4double weight, const QTGasHit* hit);  // vacuum stopped e-
+  void FillSignalColumns(NAColumnStore* store); // swap in, no copy
   void AddNtupleRow(G4int which); // close an ntuple row
 
   G4String GetFileName() {return fout;}
 
 private:
-  // internal methods for booking
-  std::vector<G4double>& GetOmVec()        { return ovec; }
-  std::vector<G4double>& GetKEVec()        { return kvec; }
-  std::vector<G4double>& GetTimeVec()      { return tvec; }
-  std::vector<G4double>& GetXVec()         { return xvec; }
-  std::vector<G4double>& GetYVec()         { return yvec; }
-  std::vector<G4double>& GetZVec()         { return zvec; }
-  std::vector<G4double>& GetBetaXVec()     { return bxvec; }
-  std::vector<G4double>& GetBetaYVec()     { return byvec; }
-  std::vector<G4double>& GetBetaZVec()     { return bzvec; }
-  std::vector<G4double>& GetAccXVec()      { return axvec; }
-  std::vector<G4double>& GetAccYVec()      { return ayvec; }
-  std::vector<G4double>& GetAccZVec()      { return azvec; }
+  // booking and row filling, either G4AnalysisManager or QTHdf5Manager
+  template <class M> void BookNtuples(M* mgr);
+  inline void FillI(G4int which, G4int col, G4int val);
+  inline void FillD(G4int which, G4int col, G4double val);
+  inline void AddRow(G4int which);
 
   G4bool    fFactoryOn = false;
   G4String  fout;
-  std::vector<G4double> ovec;    // Omega vector
-  std::vector<G4double> kvec;    // Kinteic energy vector
-  std::vector<G4double> tvec;    // time vector
-  std::vector<G4double> xvec;    // x vector
-  std::vector<G4double> yvec;    // y vector
-  std::vector<G4double> zvec;    // z vector
-  std::vector<G4double> bxvec;   // beta x vector
-  std::vector<G4double> byvec;   // beta y vector
-  std::vector<G4double> bzvec;   // beta z vector
-  std::vector<G4double> axvec;   // acc x vector
-  std::vector<G4double> ayvec;   // acc y vector
-  std::vector<G4double> azvec;   // acc z vector
+  // Signal vector columns, bound by reference at booking,
+  // in NAColumnStore column order.
+  std::array<std::vector<G4double>, NAColumnStore::kNColumns> fSignal;
 
   G4AnalysisManager* analysisManager = nullptr;
+  QTHdf5Manager*     hdf5Manager     = nullptr; // for .h5/.hdf5 file names
+
+  // Score ntuple, column handles as booked
+  static constexpr G4int fScoreID = 0;
+  enum ScoreColumn { kEventID = 0, kTrackID, kEdep, kTimeStamp, kPreKine, kPostKine,
+		     kPreTheta, kPostTheta, kPosx, kPosy, kPosz, kWeight };
+  // unit factors, output in [keV], [ns]
+  static constexpr G4double fPerkeV = 1.0 / CLHEP::keV;
+  static constexpr G4double fPerns  = 1.0 / CLHEP::ns;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -16,6 +16,7 @@
 
 // us
 #include "QTEquationOfMotion.hh"
+#include "NAColumnStore.hh"
 
 // std
 #include <stdlib.h>
@@ -39,19 +40,8 @@ public:
   inline void  operator delete(void*);
   inline int   operator==(const NATrajectory& right) const { return (this == &right); }
 
-  // access
-  std::vector<G4double>& getOm()    {return fOm;};
-  std::vector<G4double>& getKE()    {return fKE;};
-  std::vector<G4double>& getTime()  {return ft;};
-  std::vector<G4double>& getXpos()  {return xp;};
-  std::vector<G4double>& getYpos()  {return yp;};
-  std::vector<G4double>& getZpos()  {return zp;};
-  std::vector<G4double>& getBetaX() {return betax;};
-  std::vector<G4double>& getBetaY() {return betay;};
-  std::vector<G4double>& getBetaZ() {return betaz;};
-  std::vector<G4double>& getAccX()  {return accx;};
-  std::vector<G4double>& getAccY()  {return accy;};
-  std::vector<G4double>& getAccZ()  {return accz;};
+  // access, time series in output units
+  NAColumnStore*         getColumns() {return fColumns;};
 
   inline G4int GetTrackID() const override
     { return fTrackID; }
@@ -78,18 +68,7 @@ private:
   G4ThreeVector          beta;    // trajectory velocity
   G4ThreeVector          acc;     // trajectory acceleration
 
-  std::vector<G4double>  fOm;        // Omega
-  std::vector<G4double>  fKE;        // KE
-  std::vector<G4double>  ft;         // time 
-  std::vector<G4double>  xp;         // pos.x
-  std::vector<G4double>  yp;         // pos.y
-  std::vector<G4double>  zp;         // pos.z
-  std::vector<G4double>  betax;      // beta.x
-  std::vector<G4double>  betay;      // beta.y
-  std::vector<G4double>  betaz;      // beta.z
-  std::vector<G4double>  accx;       // acc.x
-  std::vector<G4double>  accy;       // acc.y
-  std::vector<G4double>  accz;       // acc.z
+  NAColumnStore*         fColumns;   // Omega, KE, time, pos, beta, acc
 
 
   G4FieldManager*        pfieldManager; // singleton for info
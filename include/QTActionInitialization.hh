@@ -11,7 +11,7 @@
 class QTActionInitialization : public G4VUserActionInitialization
 {
 public:
-  QTActionInitialization(G4String, std::vector<G4double>);
+  QTActionInitialization(G4String, std::vector<G4double>, G4int firstEvent = 0);
   ~QTActionInitialization() override;
 
   virtual void BuildForMaster() const override;
@@ -20,6 +20,7 @@ public:
 private:
   std::vector<G4double> angles;
   G4String              foutname;
+  G4int                 ffirst; // global ID of first event
 };
 
 #endif
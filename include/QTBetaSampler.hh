@@ -0,0 +1,87 @@
+// Tabulated tritium beta spectrum shared by all threads
+#ifndef QTBetaSampler_h
+#define QTBetaSampler_h 1
+
+#include "globals.hh"
+
+// std
+#include <memory>
+#include <tuple>
+#include <vector>
+
+/// Piecewise linear tritium beta spectrum with O(1) sampling.
+///
+/// Same density as std::piecewise_linear_distribution over nbins bins
+/// of TBeta::dGammadE (or dGammadEFull), tabulated once per parameter set. A bin is drawn
+/// from a Walker alias table, the energy within the bin by inverting the
+/// linear density. Instances are immutable and shared read-only between
+/// threads, obtained from Get() which builds on first request only.
+///
+/// With a cache directory, tables persist across jobs as one file per
+/// parameter set, named by a hash of the parameters. Missing tables are
+/// tabulated in parallel and written, existing ones memory-mapped.
+///
+/// Importance sampling: with biasFactor A>0 the tabulated density is
+/// the spectrum times b(E) = 1 + A exp(-(emax-E)/biasWidth), i.e. the
+/// endpoint region is oversampled. Weight(E) returns the event weight
+/// spectrum/sampled density, unit mean over the sampled distribution.
+
+class QTBetaSampler
+{
+public:
+  struct Parameters {
+    G4bool   order;       // neutrino order, true=normal
+    G4double numass;      // [keV]
+    G4double sterilemass; // [keV]
+    G4double mixing;
+    G4double emin;        // spectrum interval [keV]
+    G4double emax;
+    G4int    nbins;
+    G4bool   full;        // include continuum orbital states
+    G4double biasFactor;  // endpoint bias amplitude A, 0=none
+    G4double biasWidth;   // endpoint bias decay length [keV]
+
+    inline auto tie() const
+      { return std::tie(order, numass, sterilemass, mixing, emin, emax, nbins, full,
+			biasFactor, biasWidth); }
+    inline bool operator==(const Parameters& o) const { return tie() == o.tie(); }
+    inline bool operator<(const Parameters& o) const  { return tie() < o.tie(); }
+  };
+
+  // cacheDir empty: no disk cache
+  static std::shared_ptr<const QTBetaSampler> Get(const Parameters& par,
+						  const G4String& cacheDir = "");
+  ~QTBetaSampler();
+
+  // energy [keV] from two uniform random numbers in [0,1)
+  G4double Sample(G4double u1, G4double u2) const;
+
+  // importance weight of a sampled energy [keV], 1 without bias
+  inline G4double Weight(G4double e) const { return fBiasNorm / Bias(e); }
+
+  inline const Parameters& GetParameters() const { return fPar; }
+
+private:
+  QTBetaSampler(const Parameters& par, const G4String& cacheDir);
+  void   Tabulate();
+  void   BuildAlias();
+  G4bool Load(const G4String& fname);
+  void   Save(const G4String& fname) const;
+  G4String FileName(const G4String& cacheDir) const;
+  G4double Bias(G4double e) const;
+
+  Parameters            fPar;
+  G4double              fWidth;   // bin width [keV]
+  G4double              fBiasNorm = 1.0; // int(spectrum*b)/int(spectrum)
+  // tables, owned or in mapped file
+  const G4double*       fDensity = nullptr; // nbins+1 node values
+  const G4double*       fProb    = nullptr; // alias acceptance per bin
+  const G4int*          fAlias   = nullptr; // alias bin
+  std::vector<G4double> fDensityBuf;
+  std::vector<G4double> fProbBuf;
+  std::vector<G4int>    fAliasBuf;
+  void*                 fMap     = nullptr;
+  std::size_t           fMapSize = 0;
+};
+
+#endif
@@ -0,0 +1,72 @@
+// Columnar time-series storage for QTTrajectory
+#ifndef QTColumnStore_h
+#define QTColumnStore_h 1
+
+#include "globals.hh"
+
+// us
+#include "QTStorePool.hh"
+
+// std
+#include <vector>
+
+/// Column store for the antenna Signal ntuple time series.
+///
+/// Step columns (Omega, KE, source time) get one entry per stored step,
+/// signal columns (antenna ID, antenna time, voltage) one entry per
+/// antenna and step. Each group grows on a single capacity check.
+/// Taken from the thread-local QTStorePool by QTTrajectory; the output
+/// manager swaps the columns into its booked vectors.
+
+class QTColumnStore
+{
+public:
+  inline void AppendStep(G4double om, G4double ke, G4double st);
+  inline void AppendSignal(G4int antenna, G4double time, G4double voltage);
+  void        Clear();
+
+  inline std::vector<G4double>& GetOm()        { return fOm; }
+  inline std::vector<G4double>& GetKE()        { return fKE; }
+  inline std::vector<G4double>& GetST()        { return fST; }
+  inline std::vector<G4int>&    GetAntennaID() { return fAntennaID; }
+  inline std::vector<G4double>& GetTime()      { return fTime; }
+  inline std::vector<G4double>& GetVoltage()   { return fVoltage; }
+
+private:
+  friend class QTStorePool<QTColumnStore>;
+  QTColumnStore() = default;
+  void GrowStep();
+  void GrowSignal();
+
+  // per step
+  std::vector<G4double>  fOm;        // Omega
+  std::vector<G4double>  fKE;        // Kinetic energy [keV]
+  std::vector<G4double>  fST;        // source time [ns]
+  // per antenna and step
+  std::vector<G4int>     fAntennaID; // which antenna
+  std::vector<G4double>  fTime;      // antenna time [ns]
+  std::vector<G4double>  fVoltage;   // antenna voltage
+
+  std::size_t fStepCapacity   = 0; // smallest step column capacity
+  std::size_t fSignalCapacity = 0; // smallest signal column capacity
+
+  static constexpr std::size_t fInitialRows = 64; // doubled on demand, most tracks are short
+};
+
+inline void QTColumnStore::AppendStep(G4double om, G4double ke, G4double st)
+{
+  if (fOm.size() == fStepCapacity) GrowStep();
+  fOm.push_back(om);
+  fKE.push_back(ke);
+  fST.push_back(st);
+}
+
+inline void QTColumnStore::AppendSignal(G4int antenna, G4double time, G4double voltage)
+{
+  if (fAntennaID.size() == fSignalCapacity) GrowSignal();
+  fAntennaID.push_back(antenna);
+  fTime.push_back(time);
+  fVoltage.push_back(voltage);
+}
+
+#endif
@@ -6,9 +6,12 @@
 #include "G4UserEventAction.hh"
 #include "globals.hh"
 
+#include <chrono>
+
 /// Event action class
 ///
 class QTOutputManager;
+class QTEventTrigger;
 
 
 class QTEventAction : public G4UserEventAction
@@ -28,8 +31,11 @@ private:
   // data members
   // hit data
   QTOutputManager*      fOutput  = nullptr;
+  QTEventTrigger*       fTrigger = nullptr;
   G4int                 fGID     = -1;
   G4int                 fVID     = -1;
+  // event wall time, see QTEventCost
+  std::chrono::steady_clock::time_point fStart;
 
 };
 
@@ -0,0 +1,90 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTEventCost
+//
+// Creation date: 2026
+//
+// Event wall times, longest first event schedule, end of run tail
+//
+// -------------------------------------------------------------------
+
+#ifndef QTEventCost_h
+#define QTEventCost_h 1
+
+#include "globals.hh"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// Event cost in the trap spans orders of magnitude, from electrons
+/// leaving at once to electrons trapped up to the time limit. Workers
+/// take events in small chunks, see --event-chunk, but a costly event
+/// started late still runs on alone after all other threads are idle.
+///
+/// The wall time of each event is recorded by the event actions. At the
+/// end of a run the master reports the tail, the time from the first
+/// thread running out of events to the last one finishing, together
+/// with the slowest events. With known costs, from a cost file of an
+/// earlier run or from the previous segment pass, the next run hands
+/// out its events longest first (LPT), hence cheap events fill the gaps
+/// at the end. The cost of an event is the sum over its segments, a
+/// segment pass orders by the cost of the previous segment. Event IDs and all random numbers stay the same, only the
+/// order of processing changes, see Slot().
+
+class QTEventCost
+{
+public:
+
+  static QTEventCost& Instance();
+
+  // global ID of event 0 of a run, as the primary generator
+  void SetFirstEvent(G4int id) { fFirstEvent = id; }
+  // cost file, read now if present and rewritten after each run
+  void SetFileName(const std::string& name);
+
+  // master, begin of run: schedule of the run's events
+  void  BeginRun(G4int nEvents);
+  // index into the events of the run (or segment pass) processed as
+  // the i-th event
+  G4int  Slot(G4int i) const { return fOrder.empty() ? i : fOrder[i]; }
+  // true if Slot() is not the event order in this run
+  G4bool IsReordered() const { return !fOrder.empty(); }
+
+  // workers: wall time of an event [s], thread safe
+  void  Record(G4int eventID, G4double seconds);
+
+  // master, end of run: tail report, cost file update
+  void  EndRun();
+
+private:
+
+  QTEventCost() = default;
+
+  void save() const;
+
+  using Clock = std::chrono::steady_clock;
+  struct ThreadStats {
+    G4double          busy   = 0.0; // [s]
+    G4int             events = 0;
+    Clock::time_point last;         // end of its last event
+  };
+
+  G4int                                  fFirstEvent = 0;
+  std::string                            fFileName;
+  std::unordered_map<G4int, G4double>    fCost;  // wall time per event ID, all segments [s]
+  std::unordered_map<G4int, G4double>    fSegmentCost; // of its last segment [s]
+  std::vector<G4int>                     fOrder; // slot schedule, empty: event order
+  std::map<G4int, ThreadStats>           fThreads;
+  std::vector<std::pair<G4double, G4int>> fRun;  // (wall time, event ID) of this run
+  Clock::time_point                      fStart;
+  std::mutex                             fMutex;
+};
+
+#endif
@@ -0,0 +1,53 @@
+// Event-level trigger emulation and output filtering
+#ifndef QTEventTrigger_h
+#define QTEventTrigger_h 1
+
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+class QTColumnStore;
+class NAColumnStore;
+
+/// Event-level trigger emulation
+///
+/// An event triggers if at least one trajectory passes all cuts:
+/// vertex kinetic energy in window, stored time span (trapped time)
+/// above threshold and mean in-band signal power above threshold.
+/// In-band means cyclotron frequency Omega/2pi within the band limits.
+/// Signal power is the Larmor power [W] for the no-antenna output and
+/// the mean squared antenna voltage [V^2] for the antenna output.
+/// Non-triggering events are dropped or, in summary mode, keep their
+/// Score rows and Signal rows without time series.
+/// Commands in /QT/trigger/, inactive by default.
+
+class QTEventTrigger
+{
+public:
+  QTEventTrigger();
+  ~QTEventTrigger();
+
+  inline G4bool IsActive() const    { return fActive; }
+  inline G4bool KeepSummary() const { return fSummary; }
+
+  G4bool Accept(QTColumnStore* cols, G4double ekin) const;
+  G4bool Accept(NAColumnStore* cols, G4double ekin) const;
+
+private:
+  void DefineCommands();
+  inline G4bool InWindow(G4double ekin) const
+    { return ekin >= fEmin && ekin <= fEmax; }
+  G4bool InBand(G4double omega) const;
+
+  G4GenericMessenger* fMessenger = nullptr;
+
+  G4bool   fActive;
+  G4bool   fSummary;
+  G4double fMinTrapTime; // trapped time
+  G4double fMinPower;    // in-band power, [W] or [V^2]
+  G4double fBandLow;     // cyclotron frequency band
+  G4double fBandHigh;
+  G4double fEmin;        // vertex energy window
+  G4double fEmax;
+};
+
+#endif
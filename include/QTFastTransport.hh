@@ -0,0 +1,105 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTFastTransport
+//
+// Creation date: 2026
+//
+// Tight Boris loop transport for primary electrons in vacuum
+//
+// -------------------------------------------------------------------
+
+#ifndef QTFastTransport_h
+#define QTFastTransport_h 1
+
+#include "G4VProcess.hh"
+#include "G4ParticleChange.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <memory>
+
+class G4Navigator;
+class G4EquationOfMotion;
+class QTBorisScheme;
+
+/// Takes over the stepping of a primary electron in vacuum while it is
+/// far from any volume boundary. The process proposes the step as
+/// ExclusivelyForced, hence Geant4 skips all other step limits, the
+/// navigation and the chord finder, and moves the electron itself with
+/// QTBorisScheme pushes at a fixed gyration angle each, radiation loss
+/// included as in QTBorisDriver.
+///
+/// Each step is the propagator's largest acceptable step, the output
+/// sampling of the trajectory is therefore as with normal tracking. The
+/// electron is handed back to Geant4 when the step would leave a ball of
+/// known safety, see SetMinSafety(), the material is denser than
+/// SetMaxDensity(), the field vanishes or a user limit (time, energy,
+/// step) of the volume is in reach.
+
+class QTFastTransport : public G4VProcess
+{
+public:
+
+  explicit QTFastTransport(const G4String& name = "QTFastTransport");
+
+  ~QTFastTransport() override;
+
+  G4bool IsApplicable(const G4ParticleDefinition&) override;
+
+  void StartTracking(G4Track*) override;
+
+  G4double PostStepGetPhysicalInteractionLength(const G4Track&, G4double,
+                                                G4ForceCondition*) override;
+
+  G4VParticleChange* PostStepDoIt(const G4Track&, const G4Step&) override;
+
+  // no at rest or along step actions
+  G4double AtRestGetPhysicalInteractionLength(const G4Track&,
+                                              G4ForceCondition*) override { return -1.0; }
+  G4double AlongStepGetPhysicalInteractionLength(const G4Track&, G4double, G4double,
+                                                 G4double&, G4GPILSelection*) override { return -1.0; }
+  G4VParticleChange* AtRestDoIt(const G4Track&, const G4Step&) override { return nullptr; }
+  G4VParticleChange* AlongStepDoIt(const G4Track&, const G4Step&) override { return nullptr; }
+
+  // distance to the nearest boundary below which Geant4 transports
+  void SetMinSafety(G4double val)  { fMinSafety = val; }
+  // gyration angle per Boris push [rad]
+  void SetMaxAngle(G4double val)   { fMaxAngle = val; }
+  // vacuum: materials up to this density
+  void SetMaxDensity(G4double val) { fMaxDensity = val; }
+
+private:
+
+  // step length taken over by the Boris loop, DBL_MAX to leave the
+  // track to Geant4
+  G4double fast_step(const G4Track& track);
+
+  // true if a step of length len from pos stays clear of all boundaries
+  G4bool is_safe(const G4ThreeVector& pos, G4double len);
+
+  G4ParticleChange fParticleChange;
+
+  G4double fMinSafety;
+  G4double fMaxAngle;
+  G4double fMaxDensity;
+
+  // safety ball, own navigator, leaves the tracking navigator untouched
+  G4Navigator*  fNavigator = nullptr;
+  G4ThreeVector fSafetyOrigin;
+  G4double      fSafety     = 0.0;
+  G4bool        fHaveSafety = false;
+
+  // Boris kernel on the equation of motion of the current field manager
+  std::unique_ptr<QTBorisScheme> fScheme;
+  G4EquationOfMotion*            fEquation = nullptr;
+
+  // from step proposal to DoIt
+  G4double fStepLength = 0.0;
+  G4double fBmag       = 0.0;
+  // moved since Geant4 last located the track
+  G4bool   fMoved      = false;
+};
+
+#endif
@@ -0,0 +1,38 @@
+// QTFastTransportPhysics
+//
+//----------------------------------------------------------------------------
+//
+// Registers QTFastTransport for e-, tight Boris loop transport of primary
+// electrons in vacuum away from boundaries. Enable with --fast-transport.
+//
+
+#ifndef QTFastTransportPhysics_h
+#define QTFastTransportPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+
+class QTFastTransportPhysics : public G4VPhysicsConstructor
+{
+public:
+
+  explicit QTFastTransportPhysics(const G4String& name="QTFastTransport");
+
+  ~QTFastTransportPhysics() override;
+
+  void ConstructParticle() override;
+  void ConstructProcess() override;
+
+private:
+  void DefineCommands();
+
+  G4GenericMessenger* fMessenger = nullptr;
+  G4double            fMinSafety;  // hand back to Geant4 closer to boundaries
+  G4double            fMaxAngle;   // gyration per Boris push [rad]
+  G4double            fMaxDensity; // vacuum threshold
+};
+
+
+#endif
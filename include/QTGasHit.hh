@@ -41,7 +41,7 @@ class QTGasHit : public G4VHit
     void SetPosz        (G4double lz)  { fPosz = lz; };
 
     // Get methods
-    G4double GetTrackID()   const     { return fTrackID; };
+    G4int    GetTrackID()   const     { return fTrackID; };
     G4double GetEdep()      const     { return fEdep; };
     G4double GetTime()      const     { return fTime; };
     G4double GetPreKine()   const     { return fPreKine; };
@@ -0,0 +1,93 @@
+// Columnar HDF5 ntuple output, alternative to the ROOT analysis manager
+#ifndef QTHdf5Manager_h
+#define QTHdf5Manager_h 1
+
+#include "globals.hh"
+
+// std
+#include <cstdint>
+#include <vector>
+
+/// HDF5 ntuple writer with the subset of the G4AnalysisManager ntuple
+/// interface used by the output managers.
+///
+/// Each ntuple is a group, each column a chunked, shuffled and deflated
+/// 1D dataset. Vector columns are stored as a flat '<name>' values
+/// dataset plus '<name>_offsets' (int64, rows+1 entries starting at 0),
+/// i.e. row i holds values[offsets[i]:offsets[i+1]]. Rows are buffered
+/// and written per chunk.
+/// In MT mode every worker writes its own file '<name>_t<thread>.h5',
+/// no merging; the master opens no file.
+
+class QTHdf5Manager
+{
+public:
+  QTHdf5Manager() = default;
+  ~QTHdf5Manager();
+
+  static G4bool IsHdf5FileName(const G4String& name); // .h5 or .hdf5
+
+  G4bool OpenFile(const G4String& name);
+  G4int  CreateNtuple(const G4String& name, const G4String& title);
+  G4int  CreateNtupleIColumn(const G4String& name);
+  G4int  CreateNtupleDColumn(const G4String& name);
+  G4int  CreateNtupleIColumn(const G4String& name, std::vector<G4int>& vec);
+  G4int  CreateNtupleDColumn(const G4String& name, std::vector<G4double>& vec);
+  void   FinishNtuple();
+
+  G4bool FillNtupleIColumn(G4int id, G4int col, G4int val);
+  G4bool FillNtupleDColumn(G4int id, G4int col, G4double val);
+  G4bool AddNtupleRow(G4int id);
+
+  G4bool Write();     // flush all buffered rows
+  G4bool CloseFile();
+  void   Clear();     // drop buffered rows
+
+  inline void SetCompressionLevel(G4int level) { fCompression = level; }
+
+private:
+  using hid = std::int64_t; // hid_t, kept out of the header
+
+  struct Column {
+    G4String               name;
+    G4bool                 isInt = false;
+    std::vector<G4int>*    ivec  = nullptr; // vector column reference
+    std::vector<G4double>* dvec  = nullptr;
+    G4int                  ival  = 0;       // scalar column value
+    G4double               dval  = 0.0;
+    std::vector<G4int>        ibuf;         // pending values
+    std::vector<G4double>     dbuf;
+    std::vector<std::int64_t> obuf;         // pending offsets
+    std::int64_t           nvalues  = 0;    // running offset
+    std::int64_t           written  = 0;    // values on disk
+    std::int64_t           owritten = 0;    // offsets on disk
+    hid                    dset = -1;
+    hid                    oset = -1;
+    inline G4bool IsVector() const { return ivec || dvec; }
+  };
+
+  struct Table {
+    G4String            name;
+    G4String            title;
+    std::vector<Column> columns;
+    hid                 group    = -1;
+    std::size_t         pending  = 0; // buffered rows
+    std::size_t         pvalues  = 0; // buffered vector values
+  };
+
+  G4int  AddColumn(Column&& col);
+  void   CreateDatasets(Table& table);
+  void   Flush(Table& table);
+  void   Reset(Table& table);
+
+  std::vector<Table> fTables;
+  hid                fFile        = -1;
+  G4int              fCompression = 4;     // deflate level, 0 = off
+  G4bool             fFinished    = true;  // last ntuple finished
+
+  static constexpr std::size_t fChunkRows   = 4096;    // scalar chunk
+  static constexpr std::size_t fChunkValues = 65536;   // vector chunk
+  static constexpr std::size_t fMaxPending  = 1 << 22; // values before flush
+};
+
+#endif
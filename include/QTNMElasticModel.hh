@@ -93,13 +93,18 @@ public:
   G4double MinPrimaryEnergy(const G4Material*, const G4ParticleDefinition*,
                             G4double) override;
 
+  // no cross section for Z = 1, hydrogen left to a molecular model
+  void     SetExcludeHydrogen(G4bool val) { fExcludeHydrogen = val; }
+
 
 private:
 
-  // the object that provides cross sections and polar angle of scattering
+  // the object that provides cross sections and polar angle of scattering,
+  // created and initialised on master, shared read-only by the workers
   G4eDPWAElasticDCS*         fTheDCS;
   // particle change
   G4ParticleChangeForGamma*  fParticleChange;
+  G4bool                     fExcludeHydrogen = false;
 
 };
 
@@ -0,0 +1,63 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTNMIonisationAngles
+//
+// Creation date: 2026
+//
+// Polar angle sampling table for impact ionisation products
+//
+// -------------------------------------------------------------------
+
+#ifndef QTNMIonisationAngles_h
+#define QTNMIonisationAngles_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Polar angle distribution of primary and secondary electrons after
+/// impact ionisation, https://doi.org/10.1103/PhysRevA.44.1644
+///
+/// The density fbe + fb in theta, with
+///   fbe = 1 / (1 + ((cos theta - G2)/G3)^2),  fb = G4 / (1 + ((cos theta + 1)/G5)^2),
+/// is evaluated at 1 degree steps and taken constant over each degree, as
+/// the per collision distribution it replaces. fbe depends on (w, t) only
+/// via G2 = sqrt((w+1)/t) and G3 = 0.6 sqrt((1-G2^2)/w), fb is a fixed
+/// shape with amplitude G4(w, t).
+/// Inverse CDFs of fbe are tabulated once on a (G2, ln G3) grid and
+/// interpolated bilinearly at fixed random number; the fb part has a
+/// single inverse CDF. One instance, shared read-only by all threads.
+
+class QTNMIonisationAngles
+{
+public:
+  static const QTNMIonisationAngles& Instance();
+
+  // polar angle [rad] for w = W/B, t = T/B from two uniform random numbers
+  G4double SampleTheta(G4double w, G4double t, G4double r1, G4double r2) const;
+
+  // analytic density terms, theta [rad]
+  static G4double fbe(G4double w, G4double t, G4double theta);
+  static G4double fb(G4double w, G4double t, G4double theta);
+
+private:
+  QTNMIonisationAngles();
+
+  G4double InverseCDF(const G4double* cdf, G4double r) const; // [deg]
+
+  static const G4int    nAngles   = 181;    // 1 degree nodes
+  static const G4int    nG2       = 81;     // G2 in [0,1]
+  static const G4int    nG3       = 49;     // ln G3 grid
+  static constexpr G4double lnG3Min = -6.907755278982137; // ln 1e-3
+  static constexpr G4double lnG3Max =  6.907755278982137; // ln 1e3
+
+  std::vector<G4double> fCdf;   // nG2 x nG3 x nAngles, normalised fbe CDFs
+  std::vector<G4double> fSum;   // nG2 x nG3, fbe integral [rad]
+  std::vector<G4double> fCdfB;  // nAngles, fb shape CDF
+  G4double              fSumB;  // fb shape integral [rad]
+  G4double              fDlnG3;
+};
+
+#endif
@@ -0,0 +1,114 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTNMMolecularGasModel
+//
+// Creation date: 2026
+//
+// e- scattering on molecular hydrogen isotopes, H2, D2, T2
+//
+// -------------------------------------------------------------------
+
+#ifndef QTNMMolecularGasModel_h
+#define QTNMMolecularGasModel_h 1
+
+#include "G4VEmModel.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4ParticleChangeForGamma;
+class G4ParticleDefinition;
+class G4DataVector;
+
+/// Electron scattering on hydrogen isotope molecules with three channels:
+///  - elastic: Born cross section of Liu above 400 eV, measured values
+///    below, angles from the first Born H atom form factor,
+///  - excitation: Bethe cross section, the dipole strength left over from
+///    Liu's total inelastic one after ionisation, energy loss from the
+///    Aseev et al. T2 spectrum below the ionisation threshold,
+///  - ionisation: BEB (Kim and Rudd) for the H2 orbital, secondary energy
+///    from the BEB differential cross section, angles as the atomic model.
+/// Electronic structure and hence cross sections are the same for all
+/// isotopes. Hydrogen atoms (Z = 1) of any material count as half a
+/// molecule each, other elements have no cross section with this model.
+///
+/// All sampling is table-driven: channel cross sections on a log T grid,
+/// one excitation energy loss CDF and secondary energy CDFs on a
+/// log(T - B) grid. They do not depend on the geometry and are built
+/// once per process on first use, shared read-only by all threads.
+
+class QTNMMolecularGasModel : public G4VEmModel {
+
+public:
+
+  QTNMMolecularGasModel();
+
+  ~QTNMMolecularGasModel() override;
+
+  //
+  // Interface methods:
+
+  void     Initialise(const G4ParticleDefinition*, const G4DataVector&) override;
+
+  void     InitialiseLocal(const G4ParticleDefinition*, G4VEmModel*) override;
+
+  G4double ComputeCrossSectionPerAtom(const G4ParticleDefinition*, G4double ekin,
+                                      G4double Z, G4double A, G4double prodcut,
+                                      G4double emax) override;
+
+  void     SampleSecondaries(std::vector<G4DynamicParticle*>*,
+                             const G4MaterialCutsCouple*,
+                             const G4DynamicParticle*,
+                             G4double tmin,
+                             G4double maxEnergy) override;
+
+  G4double MinPrimaryEnergy(const G4Material*, const G4ParticleDefinition*,
+                            G4double) override { return 10.0*CLHEP::eV; }
+
+  // per molecule channel cross sections [cm^2] for kinetic energy [eV],
+  // the formulas the tables are built from
+  static G4double ElasticCrossSection(G4double T_ev);
+  static G4double ExcitationCrossSection(G4double T_ev);
+  static G4double IonisationCrossSection(G4double T_ev);
+
+private:
+
+  // excitation energy loss [eV], CDF truncated at T_ev
+  G4double sample_excitation_loss(G4double T_ev, G4double rndm) const;
+  // ionisation secondary energy [eV]
+  G4double sample_secondary_energy(G4double T_ev, G4double rndm) const;
+  // polar angle cosines from the momentum transfer distributions
+  G4double sample_elastic_cost(G4double T_ev, G4double rndm) const;
+  G4double sample_inelastic_cost(G4double T_ev, G4double loss, G4double rndm) const;
+
+  // particle change
+  G4ParticleChangeForGamma*  fParticleChange;
+
+  struct Tables {
+    // channel cross sections per molecule [cm^2] on a log T grid
+    G4double              logTmin = 0.0;
+    G4double              dlogT   = 0.0;
+    G4int                 nT      = 0;
+    std::vector<G4double> elastic, excitation, ionisation;
+    // excitation energy loss CDF on a uniform grid from excLossMin
+    std::vector<G4double> excCdf;
+    // secondary energy CDFs, nU x nW, on a log(T - B) grid in T and
+    // uniform in ln(1 + W/B) / ln(1 + Wmax/B) in W
+    G4double              logUmin = 0.0;
+    G4double              dlogU   = 0.0;
+    G4int                 nU      = 0;
+    std::vector<G4double> ionCdf;
+  };
+  static const G4int nTPerDecade = 32;
+  static const G4int nW          = 128;
+  static constexpr G4double excLossMin  = 8.0;   // [eV]
+  static constexpr G4double excLossStep = 0.01;  // [eV]
+  static void               build_tables(Tables& tables, G4double Tmax);
+  // built on first use, thread safe, up to Tmax [eV]
+  static const Tables&      shared_tables(G4double Tmax);
+  const Tables*             fTables = nullptr;
+};
+
+#endif
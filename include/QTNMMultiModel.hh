@@ -0,0 +1,50 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTNMMultiModel
+//
+// Creation date: 2026
+//
+// G4EmMultiModel passing the thread role and the master models on to
+// its sub-models
+//
+// -------------------------------------------------------------------
+
+#ifndef QTNMMultiModel_h
+#define QTNMMultiModel_h 1
+
+#include "G4EmMultiModel.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// The QTNM scattering models build their tables on the master model
+/// only and pick them up from it in InitialiseLocal. As sub-models of a
+/// G4EmMultiModel they are not registered with the process, so neither
+/// their master flag nor InitialiseLocal is set by Geant4: a worker
+/// would find no tables, or with the default master flag build its own.
+/// This class forwards both, sub-model i of a worker to sub-model i of
+/// the master.
+
+class QTNMMultiModel : public G4EmMultiModel
+{
+public:
+
+  explicit QTNMMultiModel(const G4String& name);
+
+  ~QTNMMultiModel() override = default;
+
+  // hides G4EmMultiModel::AddModel, keeps the sub-models for forwarding
+  void AddModel(G4VEmModel*);
+
+  void Initialise(const G4ParticleDefinition*, const G4DataVector&) override;
+
+  void InitialiseLocal(const G4ParticleDefinition*, G4VEmModel* masterModel) override;
+
+private:
+
+  std::vector<G4VEmModel*> fModels;
+};
+
+#endif
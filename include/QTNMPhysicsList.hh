@@ -16,8 +16,10 @@
 #define QTNMPhysicsList_h 1
 
 #include "G4VPhysicsConstructor.hh"
+#include "G4GenericMessenger.hh"
 #include "globals.hh"
 
+class QTNMMultiModel;
 
 class QTNMPhysicsList : public G4VPhysicsConstructor
 {
@@ -30,8 +32,20 @@ public:
   void ConstructParticle() override;
   void ConstructProcess() override;
 
+  // e- Coulomb scattering models, molecular model for hydrogen isotopes
+  // or atomic models for all elements; shared with QTNMTrapPhysics
+  static QTNMMultiModel* BuildElectronScatteringModels(G4bool molecularGas);
+  // /QT/physics/ commands for the e- scattering options of a constructor
+  static G4GenericMessenger* DefineElectronCommands(void* owner, G4bool& molecularGas,
+                                                    G4bool& woodcock);
+
 private:
-  G4int  verbose;
+  void DefineCommands();
+
+  G4int               verbose;
+  G4GenericMessenger* fMessenger = nullptr;
+  G4bool              fMolecularGas = false; // molecular model for hydrogen isotopes
+  G4bool              fWoodcock = false;     // null collision e- Coulomb scattering
 };
 
 
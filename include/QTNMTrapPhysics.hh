@@ -0,0 +1,42 @@
+// QTNMTrapPhysics
+//
+//----------------------------------------------------------------------------
+//
+// Lean EM physics for trapped electrons in vacuum or dilute gas: e- Coulomb
+// scattering with the QTNM elastic and impact ionisation models only.
+// Compared to QTNMPhysicsList no fluorescence, Auger, PIXE, bremsstrahlung,
+// pair production, gamma, positron, muon, hadron or ion processes, hence
+// fewer tables to build at initialisation and fewer processes per step.
+// Tables end at 1 MeV. Select with -p QTNMTrapPhysics.
+//
+
+#ifndef QTNMTrapPhysics_h
+#define QTNMTrapPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+
+class QTNMTrapPhysics : public G4VPhysicsConstructor
+{
+public:
+
+  explicit QTNMTrapPhysics(G4int ver=1, const G4String& name="");
+
+  ~QTNMTrapPhysics() override;
+
+  void ConstructParticle() override;
+  void ConstructProcess() override;
+
+private:
+  void DefineCommands();
+
+  G4int               verbose;
+  G4GenericMessenger* fMessenger = nullptr;
+  G4bool              fMolecularGas = false; // molecular model for hydrogen isotopes
+  G4bool              fWoodcock = false;     // null collision e- Coulomb scattering
+};
+
+
+#endif
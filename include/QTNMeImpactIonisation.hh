@@ -37,17 +37,16 @@
 // e- Coulomb inelastic scattering model
 //
 // -------------------------------------------------------------------
-#define STRING(x) #x
-#define XSTRING(x) STRING(x)
-
-
 #ifndef QTNMeImpactIonisation_h
 #define QTNMeImpactIonisation_h 1
 
 #include "G4VEmModel.hh"
 #include "globals.hh"
+#include <algorithm>
+#include <cmath>
 #include <map>
-#include <random>
+#include <memory>
+#include <vector>
 
 class G4ParticleChangeForGamma;
 class G4ParticleDefinition;
@@ -85,28 +84,78 @@ public:
   G4double MinPrimaryEnergy(const G4Material*, const G4ParticleDefinition*,
                             G4double) override { return 10.0*CLHEP::eV; }
 
+  // validation mode: compare cross section and secondary energy tables
+  // against the analytic formulae when built and print the deviations
+  static void SetValidation(G4bool val) { validate_tables = val; }
+
+  // no cross section for Z = 1, hydrogen left to a molecular model
+  void SetExcludeHydrogen(G4bool val) { exclude_hydrogen = val; }
+
 
 private:
 
-  void                      load_ionisation_energies(G4int Z);
-  std::vector<G4double>     get_ionisation_energies(G4int Z) { return binding_energies[Z]; };
-  G4double                  mbell_gr(G4double U, G4double J);
-  G4double                  mbell_f_ion(G4int z_eff, G4double U, G4int Z, G4double m_lambda);
-  G4double                  fbe(G4double w, G4double t, G4double theta);
-  G4double                  fb(G4double w, G4double t, G4double theta);
+  G4bool                    load_ionisation_energies(G4int Z, std::vector<G4double>& bind_vals) const;
+  G4double                  mbell_cross_section(const std::vector<G4double>& bind_vals,
+						G4int Z, G4double T_ev) const; // [cm^2]
+  G4double                  mbell_gr(G4double U, G4double J) const;
+  G4double                  mbell_f_ion(G4int z_eff, G4double U, G4int Z, G4double m_lambda) const;
   // particle change
   G4ParticleChangeForGamma*  fParticleChange;
-  // Energy space for secondary CDF
-  std::vector<G4double> secondary_energy;
-  // Theis could be made variable
+  // Secondary energy CDF, normalised, on nESpace energies log spaced
+  // from min(1e-6 T, 1e-2 bmin) to the maximum secondary energy, a power
+  // law below
   static const G4int nESpace = 200;
-  std::vector<G4double> logspace(const G4double a, const G4double b, const G4int n);
-  // Angular sampling
-  static const G4int nAngles = 181;
-  std::vector<G4double> angle = std::vector<G4double>(nAngles);
-  std::vector<G4double> angle_pdf = std::vector<G4double>(nAngles);
-  // Ionisation energies
-  std::map<int, std::vector<G4double>> binding_energies;
+  void                      secondary_cdf(const std::vector<G4double>& bind_vals,
+					  G4double T_ev, G4double* cdf) const;
+  G4double                  secondary_energy(G4double T_ev, G4double bmin, G4double pos) const;
+  // CDF tables on a log(T - bmin) grid per Z, with extra nodes either
+  // side of and above each shell threshold where the CDF jumps
+  struct SecondaryTable {
+    G4double              logTmin = 0.0; // ln(T - bmin [eV]) of first node
+    G4double              dlogT   = 0.0; // uniform grid spacing
+    G4int                 nT      = 0;   // all nodes
+    std::vector<G4double> logU;          // ln(T - bmin [eV]) of all nodes
+    std::vector<G4int>    first;         // node at uniform grid point k
+    std::vector<G4double> cdf;           // nT x nESpace
+    inline G4int          Node(G4double logu, G4double& a) const;
+  };
+  static const G4int nTPerDecade     = 32;
+  static const G4int nAbovePerDecade = 4; // in T - bind, 1e-5 to 1e-1 bind
+  void                      build_secondary_table(const std::vector<G4double>& bind_vals,
+						  SecondaryTable& table) const;
+  G4double                  sample_secondary_position(const G4double* cdf, G4double rndm) const;
+  G4double                  sample_secondary_energy(const SecondaryTable& table, G4double bmin,
+						    G4double T_ev, G4double rndm) const;
+  void                      validate_secondary_table(const std::vector<G4double>& bind_vals,
+						     G4int Z, const SecondaryTable& table) const;
+  // Cross section tables on a log(T - bmin) grid per Z, fine near the
+  // threshold
+  struct CrossSectionTable {
+    G4double              bmin    = 0.0; // lowest binding energy [eV]
+    G4double              logUmin = 0.0; // ln(T - bmin [eV]) of first node
+    G4double              dlogU   = 0.0;
+    G4int                 nT      = 0;
+    std::vector<G4double> sigma;         // [cm^2]
+    inline G4double       Value(G4double T_ev) const;
+  };
+  static const G4int nXSPerDecade = 64;
+  CrossSectionTable         build_cross_section_table(const std::vector<G4double>& bind_vals,
+						      G4int Z) const;
+  void                      validate_cross_section_table(const std::vector<G4double>& bind_vals,
+							 G4int Z, const CrossSectionTable& table) const;
+  static G4bool             validate_tables;
+  G4bool                    exclude_hydrogen = false;
+  // Per element data, built on master for the elements in the geometry
+  // and shared read-only with the workers, i.e. memory and set-up time
+  // independent of the number of threads
+  struct ElementData {
+    std::vector<G4double> binding;     // ionisation energies [eV]
+    G4double              bmin = 0.0;  // lowest ionisation energy [eV]
+    SecondaryTable        secondary;
+    CrossSectionTable     xs;
+  };
+  using ElementTables = std::map<int, ElementData>;
+  std::shared_ptr<const ElementTables> element_tables;
   // Parameters for MBELL model
   const G4int mbell_m = 3; // Fixed upto 3P
   const G4double mbell_lambda[3] = {1.270, 0.542, 0.950};  // Function of l. MBELL beyond l=1 unwise
@@ -121,12 +170,32 @@ private:
 	{-0.200e-13, -0.2356e-13,  0.5355e-13,  3.150e-13, -8.500e-13,  5.05e-13,  0.37e-13}}};
   const G4int table_n[29] = {1, 2, 2, 2, 3, 3, 3, 4, 3, 3, 4, 4, 5, 4, 4, 5, 5, 6, 4, 4, 5, 5, 6, 6, 7, 5, 5, 6, 6};
   const G4int table_l[29] = {0, 0, 1, 1, 0, 1, 1, 0, 2, 2, 1, 1, 0, 2, 2, 1, 1, 0, 3, 3, 2, 2, 1, 1, 0, 3, 3, 2, 2};
-  std::string project_root = XSTRING(SOURCE_ROOT);
   // Maximum Z allowable
   const G4int z_max = 18;
-
-  std::ranlux24       generator;
-  std::random_device  rd; // for random seeds
 };
 
+inline G4int QTNMeImpactIonisation::SecondaryTable::Node(G4double logu, G4double& a) const
+{
+  // lower node of the interval holding logu, fraction a within it
+  G4double x = (logu - logTmin) / dlogT;
+  G4int k = (x > 0.0) ? std::min((G4int)x, (G4int)first.size() - 1) : 0;
+  G4int n = first[k];
+  while (n + 2 < nT && logU[n+1] <= logu) ++n;
+  n = std::min(n, nT - 2);
+  a = std::min(std::max((logu - logU[n]) / (logU[n+1] - logU[n]), 0.0), 1.0);
+  return n;
+}
+
+inline G4double QTNMeImpactIonisation::CrossSectionTable::Value(G4double T_ev) const
+{
+  // zero at threshold, linear in log(T - bmin)
+  if (T_ev <= bmin) return 0.0;
+  G4double x = (std::log(T_ev - bmin) - logUmin) / dlogU;
+  if (x <= 0.0) return sigma[0] * (T_ev - bmin) / std::exp(logUmin);
+  if (x >= nT - 1) return sigma[nT - 1];
+  G4int i = (G4int)x;
+  G4double f = x - i;
+  return (1.0 - f) * sigma[i] + f * sigma[i+1];
+}
+
 #endif
@@ -3,10 +3,15 @@
 #define HistoManager_h 1
 
 #include "G4AnalysisManager.hh"
+#include "G4SystemOfUnits.hh"
 #include "globals.hh"
 
 #include <vector>
 
+class QTColumnStore;
+class QTGasHit;
+class QTHdf5Manager;
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 class QTOutputManager
@@ -21,17 +26,20 @@ public:
   
   void FillNtupleI(G4int which, G4int col, G4int val);
   void FillNtupleD(G4int which, G4int col, G4double val);
-  inline void FillAntennaVec(G4int val)    { avec.push_back(val); }
-  inline void FillTimeVec(G4double val)    { tvec.push_back(val); }
-  inline void FillVoltageVec(G4double val) { vvec.push_back(val); }
-  inline void FillOmVec(G4double val)      { ovec.push_back(val); }
-  inline void FillKEVec(G4double val)      { kvec.push_back(val); }
-  inline void FillSourceTime(G4double val) { stvec.push_back(val); }
+  void AddScoreRow(G4int eventID, G4double weight, const QTGasHit* hit);  // gas interaction
+  void AddStopRow(G4int eventID, G4double weight, const QTGasHit* hit);  // vacuum stopped e-
+  void FillSignalColumns(QTColumnStore* store); // swap in, no copy
   void AddNtupleRow(G4int which); // close an ntuple row
 
   G4String GetFileName() {return fout;}
 
 private:
+  // booking and row filling, either G4AnalysisManager or QTHdf5Manager
+  template <class M> void BookNtuples(M* mgr);
+  inline void FillI(G4int which, G4int col, G4int val);
+  inline void FillD(G4int which, G4int col, G4double val);
+  inline void AddRow(G4int which);
+
   // internal methods for booking
   std::vector<G4int>&    GetAntennaID()    { return avec; }
   std::vector<G4double>& GetTimeVec()      { return tvec; }
@@ -50,6 +58,15 @@ private:
   std::vector<G4double> stvec;   // source time vector
 
   G4AnalysisManager* analysisManager = nullptr;
+  QTHdf5Manager*     hdf5Manager     = nullptr; // for .h5/.hdf5 file names
+
+  // Score ntuple, column handles as booked
+  static constexpr G4int fScoreID = 0;
+  enum ScoreColumn { kEventID = 0, kTrackID, kEdep, kTimeStamp, kPreKine, kPostKine,
+		     kPreTheta, kPostTheta, kPosx, kPosy, kPosz, kWeight };
+  // unit factors, output in [keV], [ns]
+  static constexpr G4double fPerkeV = 1.0 / CLHEP::keV;
+  static constexpr G4double fPerns  = 1.0 / CLHEP::ns;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -2,7 +2,7 @@
 #define QTPrimaryGeneratorAction_h 1
 
 // std lib
-#include <random>
+#include <memory>
 
 // G4
 #include "G4VUserPrimaryGeneratorAction.hh"
@@ -10,6 +10,11 @@
 #include "Randomize.hh"
 #include "globals.hh"
 
+// us
+#include "QTBetaSampler.hh"
+#include "QTVertexFile.hh"
+#include "QTSegmentStore.hh"
+
 class G4ParticleGun;
 class G4GeneralParticleSource;
 class G4Event;
@@ -19,11 +24,13 @@ class G4Event;
 ///
 /// A single particle is generated.
 /// macro commands can change primary properties.
+/// With a vertex file, event i takes vertex i of the file.
+/// In segment passes, event i continues the i-th stopped primary.
 
 class QTPrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
 public:
-  QTPrimaryGeneratorAction();
+  QTPrimaryGeneratorAction(G4int firstEvent = 0);
   ~QTPrimaryGeneratorAction() override;
 
   virtual void GeneratePrimaries(G4Event*) override;
@@ -31,16 +38,22 @@ public:
 private:
 
   void DefineCommands();
+  // new event, by the selected generator
+  void GenerateVertex(G4Event*);
+  // continuation from a checkpoint
+  void GenerateSegment(G4Event*, const QTSegmentStore::Checkpoint&);
 
   G4ParticleGun*           fParticleGun;
   G4GeneralParticleSource* fParticleGPS;
 
   G4GenericMessenger* fMessenger;
+  G4int               fFirstEvent; // global ID offset, event range runs
 
   G4bool              fTestElectron;
   G4bool              fEGun;
   G4bool              fTritium;
   G4bool              fBespokeTritium;
+  G4bool              fContinuum;
   // electron gun parameter
   G4double            fMean;
   G4double            fStdev;
@@ -54,37 +67,19 @@ private:
   G4double            fQminusThis;
   G4double            fAngleLow;
   G4double            fAngleHigh;
+  G4String            fTableCache; // beta table directory, empty=none
+  G4double            fBiasFactor; // endpoint importance sampling
+  G4double            fBiasWidth;
+  G4String            fVertexFileName; // pre-generated vertices, empty=none
   
-  std::ranlux24       generator;
-  std::random_device  rd; // for random seeds
-};
-
-// us
-#include "TBetaGenerator.hh"
-
-// build generation functor
-// operator calls eactly one
-// distribution function.
-// Make different functor for
-// alternative distribution.
-class betaGenerator {
-private:
-  bool order_;
-  double munu_;
-  double mNu_;
-  double mixing_;
-
-public:
-  // fix parameter at construction
-  betaGenerator(bool o, double ml, double mn, double eta) :
-    order_(o),
-    munu_(ml),
-    mNu_(mn),
-    mixing_(eta) {} // with parameter constructor
-
-  double operator() (double x) {
-    return TBeta::dGammadE(order_, munu_, mNu_, mixing_, x);
-  }
+  // tabulated beta spectrum, shared, replaced on parameter change
+  std::shared_ptr<const QTBetaSampler> fBetaSampler;
+
+  // mapped vertex file, shared; read-ahead window of this thread
+  std::shared_ptr<const QTVertexFile> fVertexFile;
+  G4long              fPrefetchFrom = 0;
+  G4long              fPrefetchTo   = 0;
+  static constexpr G4long fPrefetchWindow = 8192; // vertices
 };
 
 #endif
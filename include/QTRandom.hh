@@ -0,0 +1,60 @@
+// Counter-based random numbers keyed by run seed, event and stream
+#ifndef QTRandom_h
+#define QTRandom_h 1
+
+#include "globals.hh"
+
+// std
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/// Philox4x32-10 counter-based random number service.
+///
+/// Every number is a pure function of (run seed, run ID, event ID,
+/// segment, stream ID, draw index), i.e. the custom samplers of any event
+/// can be regenerated independently, in parallel and out of order. The
+/// run ID gives each /run/beamOn of a macro new events under one seed.
+/// Segment > 0 keys the continuations of a time segmented event, see
+/// QTSegmentStore.
+/// No engine state besides one draw counter per stream and thread; no
+/// /dev/urandom.
+/// SetSeed() once before the run (from -s), BeginEvent() at the start of
+/// each event on the worker thread, which resets all stream counters.
+/// Geant4 physics and GPS keep using the Geant4 engine; SeedEngine()
+/// reseeds it per event from the kEngine stream, replacing the seeds
+/// the MT master hands out in event order.
+
+namespace QTRandom
+{
+  // one independent sequence per custom sampler
+  enum Stream { kPrimary = 0, kIonisation, kElastic, kEngine, kNStreams };
+
+  void          SetSeed(std::uint64_t seed);
+  std::uint64_t GetSeed();
+  void          BeginEvent(G4int runID, G4int eventID, G4int segment = 0);
+  G4int         GetEventID();
+  void          SeedEngine(); // Geant4 engine of this thread from the event key
+
+  G4double Flat(G4int stream);    // uniform in (0,1), never 0 or 1
+  G4double Gauss(G4int stream, G4double mean, G4double sigma);
+
+  // Philox4x32-10 block function, exposed for testing
+  std::array<std::uint32_t,4> Philox(std::array<std::uint32_t,4> ctr,
+				     std::array<std::uint32_t,2> key);
+
+  // adaptor for std distributions, UniformRandomBitGenerator
+  class Engine
+  {
+  public:
+    using result_type = std::uint32_t;
+    explicit Engine(G4int stream) : fStream(stream) {}
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    result_type operator()();
+  private:
+    G4int fStream;
+  };
+}
+
+#endif
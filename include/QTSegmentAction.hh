@@ -0,0 +1,22 @@
+#ifndef QTSegmentAction_h
+#define QTSegmentAction_h 1
+
+#include "G4UserSteppingAction.hh"
+#include "globals.hh"
+
+/// Stops the primary after a segment length of local time and records
+/// its state in the QTSegmentInfo of the event, see QTSegmentStore.
+
+class QTSegmentAction : public G4UserSteppingAction
+{
+public:
+  explicit QTSegmentAction(G4double length);
+  ~QTSegmentAction() override = default;
+
+  virtual void UserSteppingAction(const G4Step*) override;
+
+private:
+  G4double fLength; // segment length, local time
+};
+
+#endif
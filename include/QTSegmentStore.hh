@@ -0,0 +1,136 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTSegmentStore
+//
+// Creation date: 2026
+//
+// Time segmented primary tracks, checkpoints between passes
+//
+// -------------------------------------------------------------------
+
+#ifndef QTSegmentStore_h
+#define QTSegmentStore_h 1
+
+#include "G4VUserEventInformation.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class G4ParticleDefinition;
+class G4Track;
+
+/// Splits long primary tracks in time. A primary stops after the
+/// segment length of local time, QTSegmentAction, and its state is kept
+/// as a checkpoint. After the run, each checkpoint becomes an event of a
+/// further run, a pass, hence the continuations of many long tracks are
+/// spread over all workers instead of one worker tracking each to the
+/// end. Passes repeat until no primary is stopped. Segments of the same
+/// primary run one per pass: each continues from the state the previous
+/// one ended in, and the event count of a run is fixed at its start.
+/// Each run's tail is bounded by about one segment, the total wall time
+/// only by the longest primary.
+///
+/// A continuation keeps the global event ID and takes its random numbers
+/// from (event ID, segment), see QTRandom, i.e. results depend neither on
+/// the worker nor on the order of events. The time series of a stopped
+/// primary are held here and prepended to those of the next segment,
+/// the last segment writes a single row for the whole primary.
+///
+/// Configured once before the run manager initialises, SetLength() of
+/// zero leaves tracking unchanged.
+
+class QTSegmentStore
+{
+public:
+
+  struct Checkpoint {
+    G4int                       runID    = 0; // of segment 0, random key
+    G4int                       eventID  = 0;
+    G4int                       segment  = 0;
+    const G4ParticleDefinition* particle = nullptr;
+    G4ThreeVector               position;
+    G4ThreeVector               direction;
+    G4double                    ekin     = 0.0;
+    G4double                    time     = 0.0; // global
+    G4double                    weight   = 1.0;
+    // vertex of segment 0, for the output row
+    G4ThreeVector               vertexPosition;
+    G4ThreeVector               vertexDirection;
+    G4double                    vertexEnergy = 0.0;
+  };
+
+  // primary time series held between segments, output column order
+  struct Series {
+    std::vector<std::vector<G4double>> dcol;
+    std::vector<std::vector<G4int>>    icol;
+  };
+
+  static QTSegmentStore& Instance();
+
+  void     SetLength(G4double val) { fLength = val; }
+  G4double GetLength() const       { return fLength; }
+  G4bool   IsActive() const        { return fLength > 0.0; }
+
+  // workers, thread safe
+  void   Push(const Checkpoint& c);
+  // appends s to the held series of the event, s is left empty
+  void   Hold(G4int eventID, Series& s);
+  // moves the held series into s, false if none
+  G4bool Release(G4int eventID, Series& s);
+
+  // master between runs: the checkpoints of the last run become the
+  // pending events of the next pass; returns their number, zero ends
+  // the passes and resets to pass 0
+  G4int  NextPass();
+  G4int  GetPass() const { return fPass; }
+  // checkpoint for event i of the current pass
+  const Checkpoint& GetPending(G4int i) const { return fPending[i]; }
+
+  // output file of the current pass, name_seg<k> for k > 0
+  std::string PassFileName(const std::string& name) const;
+
+private:
+
+  QTSegmentStore() = default;
+
+  G4double                fLength = 0.0;
+  G4int                   fPass   = 0;
+  std::vector<Checkpoint> fPending;
+  std::vector<Checkpoint> fCollected;
+  std::map<G4int, Series> fHeld;
+  std::mutex              fMutex;
+};
+
+
+/// Segment of the current event: start state and, if the primary was
+/// stopped, the checkpoint to continue from.
+
+class QTSegmentInfo : public G4VUserEventInformation
+{
+public:
+
+  explicit QTSegmentInfo(const QTSegmentStore::Checkpoint& start) : fStart(start) {}
+
+  void Print() const override;
+
+  // records the primary state at its stop, next segment
+  void Stop(const G4Track& track);
+
+  const QTSegmentStore::Checkpoint& GetStart() const { return fStart; }
+  const QTSegmentStore::Checkpoint& GetStop() const  { return fStop; }
+  G4bool                            IsStopped() const { return fStopped; }
+
+private:
+
+  QTSegmentStore::Checkpoint fStart;
+  QTSegmentStore::Checkpoint fStop;
+  G4bool                     fStopped = false;
+};
+
+#endif
@@ -0,0 +1,60 @@
+// Thread-local pool for per-track storage objects
+#ifndef QTStorePool_h
+#define QTStorePool_h 1
+
+#include "G4Types.hh"
+
+// std
+#include <vector>
+
+/// Pool of per-track stores, one free list per thread.
+///
+/// Trajectories take a store at construction and return it on
+/// deletion, i.e. all stores of an event go back in bulk when the
+/// trajectory container is cleared at the end of the event. Stores
+/// are never deleted and keep their capacity, hence after the first
+/// few events no further heap allocation takes place.
+/// T requires a default constructor accessible to the pool and a
+/// Clear() method retaining capacity.
+
+template <class T>
+class QTStorePool
+{
+public:
+  static T*   Acquire();
+  static void Release(T* store);
+
+private:
+  static std::vector<T*>*& FreeList();
+};
+
+template <class T>
+std::vector<T*>*& QTStorePool<T>::FreeList()
+{
+  G4ThreadLocalStatic std::vector<T*>* _instance = nullptr;
+  return _instance;
+}
+
+template <class T>
+T* QTStorePool<T>::Acquire()
+{
+  auto*& freeList = FreeList();
+  if (freeList == nullptr || freeList->empty()) return new T();
+
+  T* store = freeList->back();
+  freeList->pop_back();
+  return store;
+}
+
+template <class T>
+void QTStorePool<T>::Release(T* store)
+{
+  if (store == nullptr) return;
+  store->Clear(); // keeps capacity for the next track
+
+  auto*& freeList = FreeList();
+  if (freeList == nullptr) freeList = new std::vector<T*>;
+  freeList->push_back(store);
+}
+
+#endif
@@ -16,6 +16,7 @@
 
 // us
 #include "QTEquationOfMotion.hh"
+#include "QTColumnStore.hh"
 
 // std
 #include <stdlib.h>
@@ -24,8 +25,6 @@
 
 class QTTrajectory : public G4VTrajectory
 {
-  using VTcontainer = std::vector<std::pair<double,double>>;
-
 public:
   QTTrajectory(const G4Track* aTrack, std::vector<G4double>& ang);
   ~QTTrajectory() override;
@@ -41,12 +40,8 @@ public:
   inline void  operator delete(void*);
   inline int   operator==(const QTTrajectory& right) const { return (this == &right); }
 
-  // access
-  VTcontainer&           getVT() {return fVT;};
-  std::vector<G4int>&    getAntennaID() {return fAntennaID;};
-  std::vector<G4double>& getOm() {return fOm;};
-  std::vector<G4double>& getKE() {return fKE;};
-  std::vector<G4double>& getST() {return fST;};
+  // access, time series in output units
+  QTColumnStore*         getColumns() {return fColumns;};
 
   inline G4int GetTrackID() const override
     { return fTrackID; }
@@ -74,11 +69,7 @@ private:
   G4ThreeVector          acc;     // trajectory acceleration
 
   std::vector<G4double>  fAngles;    // from geometry
-  std::vector<G4int>     fAntennaID; // antenna ID parallel to VTcontainer entries
-  std::vector<G4double>  fOm;        // Omega parallel to VTcontainer entries
-  std::vector<G4double>  fKE;        // Kinetic energy parallel to VTcontainer entries
-  std::vector<G4double>  fST;        // source time parallel to VTcontainer entries
-  VTcontainer            fVT;        // container, Cyclotron radiation pairs, time, voltage
+  QTColumnStore*         fColumns;   // Omega, KE, source time; antenna ID, time, voltage
 
   G4FieldManager*        pfieldManager; // singleton for info
   QTEquationOfMotion*    pEqn;          // info on particle
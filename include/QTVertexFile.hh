@@ -0,0 +1,54 @@
+// Memory-mapped file of pre-generated primary vertices
+#ifndef QTVertexFile_h
+#define QTVertexFile_h 1
+
+#include "globals.hh"
+
+// std
+#include <memory>
+
+/// Read-only primary vertex file shared by all threads.
+///
+/// Binary layout, little endian: a 32 byte header
+///   char magic[8] = "QTVTX", int32 version = 1, int32 ncolumns = 9,
+///   int64 nvertices, int64 reserved = 0
+/// followed by nvertices records of 9 doubles
+///   x, y, z [mm], dx, dy, dz, kinetic energy [keV], time [ns], weight.
+/// The file is memory-mapped, vertex i is used by the event with global
+/// ID i, i.e. worker threads and shards read disjoint parts of the file.
+/// Prefetch() asks the kernel to read ahead asynchronously, such that
+/// event generation does not wait for the disk.
+
+class QTVertexFile
+{
+public:
+  struct Vertex {
+    G4double x, y, z;
+    G4double dx, dy, dz;
+    G4double ekin;
+    G4double time;
+    G4double weight;
+  };
+
+  // same file for all threads, opened on first request only
+  static std::shared_ptr<const QTVertexFile> Get(const G4String& fname);
+  ~QTVertexFile();
+
+  inline G4long        Size() const            { return fSize; }
+  inline const Vertex& At(G4long i) const      { return fVertices[i]; }
+  inline const G4String& GetFileName() const   { return fName; }
+
+  // asynchronous read-ahead of vertices [from, from+n)
+  void Prefetch(G4long from, G4long n) const;
+
+private:
+  explicit QTVertexFile(const G4String& fname);
+
+  G4String      fName;
+  const Vertex* fVertices = nullptr;
+  G4long        fSize     = 0;
+  void*         fMap      = nullptr;
+  std::size_t   fMapSize  = 0;
+};
+
+#endif
@@ -0,0 +1,81 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTWoodcockScattering
+//
+// Creation date: 2026
+//
+// e- Coulomb scattering with Woodcock (null collision) tracking
+//
+// -------------------------------------------------------------------
+
+#ifndef QTWoodcockScattering_h
+#define QTWoodcockScattering_h 1
+
+#include "G4CoulombScattering.hh"
+#include "globals.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <vector>
+
+/// G4CoulombScattering with the same models, interaction points sampled
+/// against a majorant cross section instead of the one of the current
+/// material. The majorant is the maximum macroscopic cross section over
+/// the materials of a region, tabulated in energy only, hence within a
+/// region the step proposal is a plain countdown, unchanged at gas
+/// boundaries. At a tentative collision the true cross section is
+/// evaluated once and the collision accepted with probability
+/// sigma / majorant; rejected (null) collisions leave the electron
+/// untouched and create no hits.
+///
+/// A region with a single non-vacuum material has nothing to gain: the
+/// binned majorant would only add null collisions. Its couple keeps the
+/// exact cross section of the plain process.
+///
+/// Vacuum, materials up to vacuumDensity, has no majorant: the process
+/// proposes no step there and field propagation runs uninterrupted. The
+/// number of interaction lengths left carries over between regions as
+/// for any discrete process.
+
+class G4MaterialCutsCouple;
+
+class QTWoodcockScattering : public G4CoulombScattering
+{
+public:
+
+  QTWoodcockScattering();
+
+  ~QTWoodcockScattering() override = default;
+
+  void BuildPhysicsTable(const G4ParticleDefinition&) override;
+
+  G4double PostStepGetPhysicalInteractionLength(const G4Track&, G4double,
+                                                G4ForceCondition*) override;
+
+  G4VParticleChange* PostStepDoIt(const G4Track&, const G4Step&) override;
+
+  // majorant macroscopic cross section [1/length] of a couple at
+  // ln(ekin), zero in vacuum and for couples with the exact one
+  G4double Majorant(const G4MaterialCutsCouple*, G4double logEkin) const;
+
+private:
+
+  void build_majorant();
+
+  // per region: maxima per log energy bin over its couples in use
+  std::vector<std::vector<G4double>> fMajorant;
+  // couple index -> region table, kVacuum or kExact
+  std::vector<G4int>                 fGroup;
+  static const G4int kVacuum = -1;
+  static const G4int kExact  = -2;   // plain G4CoulombScattering
+  G4double              fLogEmin  = 0.0;
+  G4double              fInvDlogE = 0.0;
+  G4bool                fWarned   = false;
+
+  static constexpr G4double majorantMargin = 1.05;
+  static constexpr G4double vacuumDensity  = 1.0e-20*CLHEP::g/CLHEP::cm3;
+  static const G4int        nSubPoints     = 4;   // cross section samples per bin
+};
+
+#endif
@@ -3,9 +3,11 @@
 #ifndef TBCONSTANTS_HH
 #define TBCONSTANTS_HH 1
 
+#include <algorithm>
 #include <cmath>
 #include <array>
 #include <complex>
+#include <cstddef>
 #include <functional>
 
 // references for value updates:
@@ -110,6 +112,55 @@ namespace TBeta
     }
   };
   
+  // Gauss-Legendre nodes and weights on [-1,1], Newton iteration
+  // on the Legendre polynomial roots, computed once per order.
+  template <int N>
+  struct GaussLegendre {
+    double x[N];
+    double w[N];
+    GaussLegendre() {
+      for (int i=0;i<N;++i) {
+	double z  = std::cos(pi*(i+0.75)/(N+0.5)); // initial guess
+	double dp = 0.0;
+	for (int it=0;it<100;++it) {
+	  double p0 = 1.0, p1 = 0.0;
+	  for (int j=1;j<=N;++j) {
+	    double p2 = p1;
+	    p1 = p0;
+	    p0 = ((2.0*j-1.0)*z*p1 - (j-1.0)*p2)/j;
+	  }
+	  dp = N*(z*p0-p1)/(z*z-1.0);
+	  double dz = p0/dp;
+	  z -= dz;
+	  if (std::abs(dz)<1.0e-15) break;
+	}
+	x[i] = z;
+	w[i] = 2.0/((1.0-z*z)*dp*dp);
+      }
+    }
+  };
+
+  template <int N>
+  inline const GaussLegendre<N>& gaussLegendre() {
+    static const GaussLegendre<N> gl; // thread-safe initialisation
+    return gl;
+  }
+
+  // Composite N-point Gauss-Legendre integral of f over [from,to].
+  // Integrand as template argument, inlined unlike std::function.
+  template <int N, class F>
+  inline double integrateGL(F&& f, double from, double to, int panels) {
+    const GaussLegendre<N>& gl = gaussLegendre<N>();
+    double h = (to-from)/panels;
+    double s = 0.0;
+    for (int k=0;k<panels;++k) {
+      double c = from + (k+0.5)*h;
+      for (int i=0;i<N;++i)
+	s += gl.w[i]*f(c + 0.5*h*gl.x[i]);
+    }
+    return 0.5*h*s;
+  }
+
   // Collect inline functions in one specific place
   // Refs quoted:
   // [1] Preprint arXiv 1806.00369
@@ -173,6 +224,43 @@ namespace TBeta
     return fac1 * std::exp(pi*(etab-eta)) * nom/denom;
   }
   
+  // Re ln Gamma(x+iy) for x>0 in real arithmetic: shift by K=8 with
+  // the recurrence, then Stirling series to 1/z^7 (abs. error < 1e-11).
+  // Branch free, i.e. vectorisable, unlike the complex Lanczos Gamma.
+  inline double lnGammaRe(double x, double y) {
+    double y2   = y*y;
+    double prod = 1.0;
+    for (int k=0;k<8;++k) prod *= (x+k)*(x+k) + y2; // |z+k|^2
+    double X  = x + 8.0;
+    double r2 = X*X + y2;  // |z+8|^2
+    double i2 = 1.0/r2;
+    double X2 = X*X;
+    double re1 = X*i2;                                          // Re 1/z
+    double re3 = X*(X2 - 3.0*y2)*i2*i2*i2;                      // Re 1/z^3
+    double re5 = X*(X2*X2 - 10.0*X2*y2 + 5.0*y2*y2)*i2*i2*i2*i2*i2;
+    double re7 = X*(X2*X2*X2 - 21.0*X2*X2*y2 + 35.0*X2*y2*y2 - 7.0*y2*y2*y2)
+      *i2*i2*i2*i2*i2*i2*i2;
+    double stirling = (X-0.5)*0.5*std::log(r2) - y*std::atan(y/X) - X
+      + 0.5*std::log(twopi) + re1/12.0 - re3/360.0 + re5/1260.0 - re7/1680.0;
+    return stirling - 0.5*std::log(prod);
+  }
+
+  // S(Z,en) with the Gamma ratio |G(gamma+i etab)|^4/|G(gamma+i eta)|^4
+  // from lnGammaRe, relative deviation from S below 1e-10.
+  inline double Sfast(int Z, double en) {
+    if (en<emin) return 1.0;
+    double w  = (en + me) / me; // total electron energy [me]
+    double p  = std::sqrt(w*w - 1.0);
+    double wb = w - v0 / me;
+    double pb = std::sqrt(wb*wb - 1.0);
+    double eta   = alpha * Z*w/p;
+    double etab  = alpha * Z*wb/pb;
+    double gamma = std::sqrt(1.0-(alpha*alpha*Z*Z));
+    double fac1 = wb/w*std::pow(pb/p, -1.0+2.0*gamma);
+    double lnratio = 4.0*(lnGammaRe(gamma, etab) - lnGammaRe(gamma, eta));
+    return fac1 * std::exp(pi*(etab-eta) + lnratio);
+  }
+  
   // Scaling od the electric field within nucleus [1] (A.7)
   inline double L(int Z, double en) {
     double w  = (en + me) / me; // total electron energy [me]
@@ -217,6 +305,39 @@ namespace TBeta
     return Fermi(2,arg)*S(2,en)*G(en,e0)*L(2,en)*CC(2,en,e0)*Q(2,en,e0);
   }
 
+  // Electron energy dependent factors of the decay rate, independent of
+  // atomic level and neutrino mass, computed once per energy (en>=emin).
+  struct ElectronFactors {
+    double en;   // electron energy [keV]
+    double w;    // total electron energy [me]
+    double fsl;  // Fermi*S*L
+    double gexp; // G exponent 2 alpha t/pi
+    double gt;   // t in G
+    double gA0;  // w0 independent part of G bracket
+    explicit ElectronFactors(double e) : en(e) {
+      w = (en + me) / me;
+      double p    = std::sqrt(w*w - 1.0);
+      double beta = p/w;
+      fsl  = Fermi(2,beta)*Sfast(2,en)*L(2,en);
+      gt   = (1.0/beta)*std::atanh(beta) - 1.0;
+      gexp = 2.0*alpha*gt/pi;
+      gA0  = gt*(std::log(2.0) - 3.0/2.0) + (gt+1)/4.0*(2.0*(1.0+beta*beta) + 2.0*std::log(1.0-beta))
+	- 2.0 + beta/2.0 - 17.0/36.0*beta*beta + 5.0/6.0*beta*beta*beta;
+    }
+    // same as G(en, endp)
+    inline double Gc(double endp) const {
+      double dw = (endp - en) / me; // w0-w
+      if (dw<=0.0) return 0.0;
+      double term = gA0 + gt*dw/w + (gt+1)/4.0*dw*dw/(6.0*w*w);
+      return std::pow(dw, gexp)*(1.0 + 2.0*alpha/pi*term);
+    }
+    // same as Corr(en, munu, n) for endpoint e0=endAt(munu, n)
+    inline double Corr(double e0) const {
+      if (e0<=en) return 1.0;
+      return fsl*Gc(e0)*CC(2,en,e0)*Q(2,en,e0);
+    }
+  };
+
   // Differential decay rate with energy en [kev], applicable to LH SM currents
   // for the emission of an electron antineutrino with mass munu [kev] and 
   // the endpoint of the n-th 3He energy level. With corrections.
@@ -309,6 +430,50 @@ namespace TBeta
     return sum;
   }
   
+  // Batch form of dGammadE over n energies en[], result in out[].
+  // Endpoints and neutrino weights are set up once per call, energy
+  // dependent factors once per energy instead of per level and mass.
+  inline void dGammadE(bool order, double munu, double mN, double eta,
+		       const double* en, double* out, std::size_t n) {
+    const std::array<double,3>& UeSq = order ? UeSqNO : UeSqIO;
+    const std::array<double,3>  nu   = nuSpectrum(order, munu);
+    const double mass[4] = {nu[0], nu[1], nu[2], mN};
+    const double wgt[4]  = {(1.0-eta*eta)*UeSq[0], (1.0-eta*eta)*UeSq[1],
+			    (1.0-eta*eta)*UeSq[2], eta*eta};
+    double e0[5][4];
+    for (int l=0;l<5;++l)
+      for (int i=0;i<4;++i) e0[l][i] = endAt(mass[i], l+1);
+    // Lev(n,en) = 2(c1 + aL^2/n^3 - c2 aL) for n!=2, c1, c2 constant
+    double c1[5], c2[5];
+    for (int l=0;l<5;++l) {
+      int m = l+1;
+      c1[l] = 256.0*std::pow(m, 5)*std::pow(m-2, 2*m-4)/std::pow(m+2, 2*m+4);
+      c2[l] = 16.0*m*std::pow(m-2, m-2)/std::pow(m+2, m+2);
+    }
+
+    for (std::size_t k=0;k<n;++k) {
+      double e = en[k];
+      if (e<emin) { out[k] = 0.0; continue; } // stub vanishes
+      ElectronFactors ef(e);
+      double al  = aL(e);
+      double sum = 0.0;
+      for (int l=0;l<5;++l) {
+	double lsum = 0.0;
+	for (int i=0;i<4;++i) {
+	  if (wgt[i]==0.0 || e0[l][i]<e) continue; // stub vanishes
+	  double d = stub(e, mass[i], e0[l][i]) * ef.Corr(e0[l][i]);
+	  if (i==3) d *= heavyside(e0[l][i]-e); // sterile
+	  lsum += wgt[i]*d;
+	}
+	int m = l+1;
+	double lev = (m==2) ? 0.25*(1.0 + al*al - al)
+	  : 2.0*(c1[l] + al*al/(m*m*m) - c2[l]*al);
+	sum += lev * lsum;
+      }
+      out[k] = sum;
+    }
+  }
+  
   // Set up all contributions including continous states and first 5 
   // discrete states. Here consider state n as double for continuum states.
   inline double endCont(double munu, double n) {
@@ -328,34 +493,78 @@ namespace TBeta
     return fac * CorrCont(en, munu, n);
   }
   
-  // integrand over states g
+  // integrand over states g, gammaCont() evaluates the same with
+  // energy dependent factors hoisted
   inline double integrand(double g, double en, double munu) {
     double fac1 = DiffCont(en, munu, g)*twopi/(g*g*g*(std::exp(twopi*g)-1.0));
     double fac2 = g*g*g*g*std::exp(2.0*g*std::atan(-2.0/g))/((1.0+g*g/4.0)*(1.0+g*g/4.0));
     return fac1*(fac2*fac2 + aL(en)*aL(en) - aL(en)*fac2);
   }
   
+  // Continuum integrand factors depending on electron energy only
+  struct ContFactors : ElectronFactors {
+    double al;   // aL(en)
+    double etal; // etaL(en), upper integration limit
+    explicit ContFactors(double e) : ElectronFactors(e), al(aL(e)), etal(etaL(e)) {}
+  };
+
   // Contribution only from the continuum orbital electron states.
-  // integrate over g.
+  // Integrate integrand() over g in [-99, etaL(en)], substituting
+  // g=-1/t and ending at the state with endpoint en. Panels are
+  // compressed towards that end, t=thi-(thi-tlo)(1-x)^2.
+  inline double gammaCont(const ContFactors& cf, double munu) {
+    double en = cf.en;
+    if (en<emin) return 0.0;
+    double e1  = endAt(munu, 1);
+    double tc2 = (e1-en)/(4.0*Ryd) - 1.0; // t^2 where endCont(munu, g)=en
+    if (tc2<=0.0) return 0.0;
+    double tlo = 1.0/99.0;
+    double thi = std::min(-1.0/cf.etal, std::sqrt(tc2));
+    if (thi<=tlo) return 0.0;
+    double dt  = thi - tlo;
+    auto f = [&cf, en, munu, e1, tlo, dt](double x) {
+      double t   = tlo + dt*x*(2.0-x);
+      double jac = 2.0*dt*(1.0-x)/(t*t); // dg/dx
+      double g   = -1.0/t;
+      double e0  = e1 - 4.0*Ryd*(1.0+t*t); // endCont(munu, g)
+      double st  = stub(en, munu, e0);
+      if (st==0.0) return 0.0;
+      double corr = cf.fsl*cf.Gc(e0)*CC(2,en,e0)*Q(2,en,e0);
+      double fac1 = st*corr*twopi/(g*g*g*(std::exp(twopi*g)-1.0));
+      double q    = 1.0 + g*g/4.0;
+      double fac2 = g*g*g*g*std::exp(2.0*g*std::atan(-2.0/g))/(q*q);
+      return fac1*(fac2*fac2 + cf.al*cf.al - cf.al*fac2)*jac;
+    };
+    return integrateGL<16>(f, 0.0, 1.0, 8)/pi;
+  }
+
   inline double gammaCont(double en, double munu) {
-    if (en > endCont(munu, 1e10) || en<emin) return 0.0;
-    std::function<double(double,double,double)> fn = integrand;
-    SimpsonIntegral sint(fn, en, munu);
-    return sint.integrate(-99, etaL(en), 1000)/pi;
+    if (en<emin) return 0.0;
+    return gammaCont(ContFactors(en), munu);
   }
   
   inline double dGammadECont(bool order, double munu, double mN, double eta, double en) {
+    if (en<emin) return 0.0;
     const std::array<double,3>& UeSq = order ? UeSqNO : UeSqIO;
+    const std::array<double,3>  nu   = nuSpectrum(order, munu);
+    ContFactors cf(en); // shared by all neutrino masses
     double sum = 0.0;
     for (int i=0;i<3;++i) {
-      sum += UeSq[i] * gammaCont(en, nuSpectrum(order,munu)[i]);
+      sum += UeSq[i] * gammaCont(cf, nu[i]);
     }
-    return (1-eta*eta)*sum + eta*eta*gammaCont(en, mN);
+    return (1-eta*eta)*sum + eta*eta*gammaCont(cf, mN);
   }
   
   inline double dGammadEFull(bool order, double munu, double mN, double eta, double en) {
     return dGammadE(order, munu, mN, eta, en) + dGammadECont(order, munu, mN, eta, en);
   }
+  // Batch form of dGammadEFull
+  inline void dGammadEFull(bool order, double munu, double mN, double eta,
+			   const double* en, double* out, std::size_t n) {
+    dGammadE(order, munu, mN, eta, en, out, n);
+    for (std::size_t k=0;k<n;++k)
+      out[k] += dGammadECont(order, munu, mN, eta, en[k]);
+  }
 } // namespace TBeta
 
 #endif
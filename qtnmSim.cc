@@ -3,6 +3,10 @@
 
 // standard
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -18,25 +22,147 @@
 
 #include "G4RunManagerFactory.hh"
 #include "G4UImanager.hh"
+#include "G4UIcommandStatus.hh"
 #include "G4Threading.hh"
 #include "G4GenericPhysicsList.hh"
 #include "G4VModularPhysicsList.hh"
 #include "G4GDMLParser.hh"
 #include "G4LogicalVolume.hh"
 #include "G4StepLimiterPhysics.hh"
+#include "G4SystemOfUnits.hh"
+
+#ifdef QTNM_WITH_MPI
+#  include <mpi.h>
+#endif
 
 // us
 #include "CLI11.hpp"  // c++17 safe; https://github.com/CLIUtils/CLI11
 #include "QTDetectorConstruction.hh"
 #include "QTActionInitialization.hh"
+#include "QTRandom.hh"
+#include "QTFastTransportPhysics.hh"
+#include "QTSegmentStore.hh"
+#include "QTEventCost.hh"
+
+// Insert tag before the file extension, if any.
+static void tagFileName(std::string& name, const std::string& tag)
+{
+  std::size_t dot = name.rfind('.');
+  if (dot == std::string::npos || name.find('/', dot) != std::string::npos)
+    dot = name.size();
+  name.insert(dot, tag);
+}
+
+
+// Execute a macro line by line as /control/execute does, replacing the
+// event count of /run/beamOn by nevents, unless negative. Each run is
+// followed by the passes of time segmented primaries, see QTSegmentStore.
+// Top-level macro only, nested macros run unchanged.
+static int executeMacro(G4UImanager* ui, const std::string& name, int nevents)
+{
+  std::ifstream in(name);
+  if (!in) {
+    G4cerr << "Cannot open macro " << name << G4endl;
+    return 1;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    std::size_t from = line.find_first_not_of(" \t\r");
+    if (from == std::string::npos || line[from] == '#') continue;
+    std::string cmd = line.substr(from, line.find_last_not_of(" \t\r") - from + 1);
+    G4bool beamOn = (cmd.rfind("/run/beamOn", 0) == 0);
+    if (beamOn && nevents >= 0)
+      cmd = "/run/beamOn " + std::to_string(nevents);
+    if (ui->ApplyCommand(cmd) != fCommandSucceeded) {
+      G4cerr << "Macro command failed: " << cmd << G4endl;
+      return 1;
+    }
+    if (!beamOn) continue;
+    for (G4int n; (n = QTSegmentStore::Instance().NextPass()) > 0; ) {
+      if (ui->ApplyCommand("/run/beamOn " + std::to_string(n)) != fCommandSucceeded) {
+        G4cerr << "Segment pass failed" << G4endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+
+#ifdef QTNM_WITH_MPI
+// MPI around the whole run, finalised on every return path. Ranks run
+// disjoint shards of the event range, each with its own run manager,
+// threads and output file.
+struct MpiSession
+{
+  int rank = 0, size = 1, localSize = 1; // localSize: ranks on this node
+
+  MpiSession(int* argc, char*** argv)
+  {
+    MPI_Init(argc, argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm local;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &local);
+    MPI_Comm_size(local, &localSize);
+    MPI_Comm_free(&local);
+  }
+  ~MpiSession() { MPI_Finalize(); }
+
+  // status, wall time and output file of all ranks reported by rank 0;
+  // returns the worst status on all ranks
+  int Gather(int status, const std::string& file, double seconds) const
+  {
+    const int len = 512;
+    char name[len] = {0};
+    std::strncpy(name, file.c_str(), len - 1);
+    std::vector<int>    st(size);
+    std::vector<double> wt(size);
+    std::vector<char>   names((std::size_t)size * len);
+    MPI_Gather(&status, 1, MPI_INT, st.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Gather(&seconds, 1, MPI_DOUBLE, wt.data(), 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    MPI_Gather(name, len, MPI_CHAR, names.data(), len, MPI_CHAR, 0, MPI_COMM_WORLD);
+    int worst = 0;
+    if (rank == 0) {
+      double sum = 0.0, tmax = 0.0;
+      for (int k = 0; k < size; ++k) {
+        G4cout << "MPI rank " << k << ": " << &names[(std::size_t)k * len] << ", "
+               << wt[k] << " s" << (st[k] ? ", FAILED" : "") << G4endl;
+        worst = std::max(worst, st[k]);
+        sum  += wt[k];
+        tmax  = std::max(tmax, wt[k]);
+      }
+      G4cout << "MPI " << size << " ranks, wall time max " << tmax << " s, mean "
+             << sum / size << " s" << G4endl;
+    }
+    MPI_Bcast(&worst, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    return worst;
+  }
+};
+#endif
+
 
 int main(int argc, char** argv)
 {
+#ifdef QTNM_WITH_MPI
+  MpiSession mpi(&argc, &argv);
+  auto wallStart = std::chrono::steady_clock::now();
+#endif
+
   // command line interface
   CLI::App    app{ "QTNM simulation app" };
   int         nthreads = 4;
   int         seed     = 1234;
   bool        antennaSim = false;
+  bool        fastTransport = false;
+  double      segmentTime   = 0.0; // [ns], 0 = off
+  int         eventChunk    = 1;   // events per worker request
+  std::string runManagerType("Default");
+  std::string costFileName;
+  int         firstEvent = 0;
+  int         nEvents    = -1; // as in macro
+  int         eventID    = -1;
+  std::string shard;
   std::string outputFileName("qtnm.root");
   std::string macroName;
   std::string gdmlFileName("example.gdml");
@@ -47,12 +173,74 @@ int main(int argc, char** argv)
   app.add_option("-p,--physlist", physListName, "<Geant4 physics list macro> Default: QTNMPhysicsList");
   app.add_option("-s,--seed", seed, "<Geant4 random number seed + offset 1234> Default: 1234");
   app.add_option("-o,--outputFile", outputFileName,
-                 "<FULL PATH ROOT FILENAME> Default: qtnm.root");
+                 "<FULL PATH ROOT FILENAME, .h5 for HDF5> Default: qtnm.root");
   app.add_option("-t, --nthreads", nthreads, "<number of threads to use> Default: 4");
   app.add_option("-a, --antenna", antennaSim, "<Boolean switch for Antenna simulation> Default: false");
+  app.add_option("--first-event", firstEvent, "<global ID of the first event> Default: 0");
+  app.add_option("--n-events", nEvents,
+                 "<number of events, replaces /run/beamOn count; total with --shard> Default: macro");
+  app.add_option("--shard", shard, "<k/N, run part k of N of the event range> Default: None");
+  app.add_option("--event", eventID, "<re-run this single event ID> Default: None");
+  app.add_flag("--fast-transport", fastTransport,
+               "<Boris loop transport of primary e- in vacuum away from boundaries> Default: false");
+  app.add_option("--run-manager", runManagerType,
+                 "<Geant4 run manager: Default, Serial, MT, Tasking, TBB> Default: Default, G4RUN_MANAGER_TYPE");
+  app.add_option("--event-chunk", eventChunk,
+                 "<events per worker request, 0 = Geant4 default> Default: 1");
+  app.add_option("--event-costs", costFileName,
+                 "<event wall time file, read for a longest first event order, updated after each run> Default: None");
+  app.add_option("--segment-time", segmentTime,
+                 "<split primaries into segments of this time [ns], continued in further runs> Default: 0, off");
 
   CLI11_PARSE(app, argc, argv);
 
+#ifdef QTNM_WITH_MPI
+  // one shard per rank of the --n-events range
+  if (mpi.size > 1) {
+    if (!shard.empty() || eventID >= 0) {
+      G4cout << "--shard and --event are set per rank under MPI, do not give them" << G4endl;
+      return 1;
+    }
+    shard = std::to_string(mpi.rank) + "/" + std::to_string(mpi.size);
+  }
+#endif
+
+  // event range, all random numbers of an event follow from (seed, event ID)
+  // hence shards and single events reproduce a monolithic run exactly
+  std::string rangeTag;
+  if (eventID >= 0) {
+    firstEvent = eventID;
+    nEvents    = 1;
+    rangeTag   = "_ev" + std::to_string(eventID);
+  }
+  else if (!shard.empty()) {
+    int  k = -1, n = 0;
+    char slash = ' ';
+    std::istringstream is(shard);
+    is >> k >> slash >> n;
+    if (!is || slash != '/' || n < 1 || k < 0 || k >= n || nEvents < 0) {
+      G4cout << "--shard needs k/N with 0<=k<N and the total --n-events" << G4endl;
+      return 1;
+    }
+    long long total = nEvents;
+    int lo     = firstEvent + (int)(total*k/n);
+    int hi     = firstEvent + (int)(total*(k+1)/n);
+    firstEvent = lo;
+    nEvents    = hi - lo;
+    rangeTag   = "_shard" + std::to_string(k) + "of" + std::to_string(n);
+  }
+  else if (firstEvent > 0 || nEvents >= 0) {
+    rangeTag = "_ev" + std::to_string(firstEvent);
+    if (nEvents >= 0) rangeTag += "-" + std::to_string(firstEvent + nEvents - 1);
+  }
+  if (!rangeTag.empty()) { // tag output and cost file
+    tagFileName(outputFileName, rangeTag);
+    if (!costFileName.empty()) tagFileName(costFileName, rangeTag);
+    G4cout << "Event range: first event " << firstEvent << ", events "
+           << (nEvents >= 0 ? std::to_string(nEvents) : std::string("from macro"))
+           << ", output " << outputFileName << G4endl;
+  }
+
   // GEANT4 code
   // Get the pointer to the User Interface manager
   //
@@ -67,16 +255,23 @@ int main(int argc, char** argv)
 
   // set the random seed + offset 1234; avoiding zero seed -> runtime error
   CLHEP::HepRandom::setTheSeed(1234+seed);
+  QTRandom::SetSeed(1234+seed); // custom samplers, counter-based
 
   // -- Construct the run manager : MT or sequential one
-  auto* runManager = G4RunManagerFactory::CreateRunManager();
+  auto* runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerFactory::GetType(runManagerType));
 #ifdef G4MULTITHREADED
-  nthreads =
-    std::min(nthreads, G4Threading::G4GetNumberOfCores());  // limit thread number to
-                                                            // max on machine
+  G4int ncores = G4Threading::G4GetNumberOfCores();
+#  ifdef QTNM_WITH_MPI
+  ncores = std::max(1, ncores / mpi.localSize); // ranks on a node share its cores
+#  endif
+  nthreads = std::min(nthreads, ncores);  // limit thread number to max on machine
   G4cout << "      ********* Run Manager constructed in MT mode: " << nthreads
          << " threads ***** " << G4endl;
   runManager->SetNumberOfThreads(nthreads);
+  // small chunks: workers take new events as they finish, no thread
+  // holds a backlog while others are idle; results do not depend on it
+  if (auto* mtManager = dynamic_cast<G4MTRunManager*>(runManager))
+    if (eventChunk > 0) mtManager->SetEventModulo(eventChunk);
 #endif
 
 
@@ -120,20 +315,42 @@ int main(int argc, char** argv)
   // Register Step limiter
   physList->RegisterPhysics(new G4StepLimiterPhysics());
 
+  // optional fast vacuum transport, takes over from all processes above
+  if (fastTransport) physList->RegisterPhysics(new QTFastTransportPhysics());
+
   // finish physics list
   runManager->SetUserInitialization(physList);
 
 
+  // time segments of long primaries, before the workers build their actions
+  QTSegmentStore::Instance().SetLength(segmentTime*ns);
+
+  // event wall times: tail report, longest first order from known costs
+  QTEventCost::Instance().SetFirstEvent(firstEvent);
+  if (!costFileName.empty()) QTEventCost::Instance().SetFileName(costFileName);
+
   // -- Set user action initialization class.
   // vector angles decides between simulation types: empty = no antenna output.
-  auto* actions = new QTActionInitialization(outputFileName, angles);
+  auto* actions = new QTActionInitialization(outputFileName, angles, firstEvent);
   runManager->SetUserInitialization(actions);
 
 
   // Batch mode only - no visualisation
-  G4String command = "/control/execute ";
-  UImanager->ApplyCommand(command + macroName);
+  int status = 0;
+  if (nEvents >= 0 || segmentTime > 0.0) { // event count from command line, segment passes
+    status = executeMacro(UImanager, macroName, nEvents);
+  }
+  else {
+    G4String command = "/control/execute ";
+    UImanager->ApplyCommand(command + macroName);
+  }
 
   delete runManager;
-  return 0;
+
+#ifdef QTNM_WITH_MPI
+  if (mpi.size > 1)
+    status = mpi.Gather(status, outputFileName,
+                        std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count());
+#endif
+  return status;
 }
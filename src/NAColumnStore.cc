@@ -0,0 +1,21 @@
+#include "NAColumnStore.hh"
+
+#include <algorithm>
+
+
+void NAColumnStore::Clear()
+{
+  // columns may have been swapped with the output manager vectors
+  fCapacity = fColumns[0].capacity();
+  for (auto& col : fColumns) {
+    col.clear();
+    fCapacity = std::min(fCapacity, col.capacity());
+  }
+}
+
+
+void NAColumnStore::Grow()
+{
+  fCapacity = std::max(fInitialRows, 2*fCapacity);
+  for (auto& col : fColumns) col.reserve(fCapacity);
+}
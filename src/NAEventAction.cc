@@ -2,8 +2,10 @@
 #include "NAOutputManager.hh"
 #include "NATrajectory.hh"
 #include "QTGasSD.hh"
-
-#include <vector>
+#include "QTEventTrigger.hh"
+#include "QTSegmentStore.hh"
+#include "QTEventCost.hh"
+#include "NAColumnStore.hh"
 
 #include "G4Event.hh"
 #include "G4TrajectoryContainer.hh"
@@ -11,17 +13,41 @@
 #include "G4SDManager.hh"
 #include "G4UnitsTable.hh"
 #include "G4ios.hh"
-#include "G4AnalysisManager.hh"
+#include "G4SystemOfUnits.hh"
+
+
+namespace {
+  // primary series of a time segment, NAColumnStore column order
+  void holdColumns(NAColumnStore* store, QTSegmentStore::Series& s)
+  {
+    s.dcol.resize(NAColumnStore::kNColumns);
+    for (G4int c = 0; c < NAColumnStore::kNColumns; ++c)
+      s.dcol[c].swap(store->GetColumn(c));
+  }
+
+  void prependColumns(QTSegmentStore::Series& s, NAColumnStore* store)
+  {
+    for (G4int c = 0; c < NAColumnStore::kNColumns; ++c) {
+      std::vector<G4double>& held = s.dcol[c];
+      held.insert(held.end(), store->GetColumn(c).begin(), store->GetColumn(c).end());
+      held.swap(store->GetColumn(c));
+    }
+  }
+}
 
 
 NAEventAction::NAEventAction(NAOutputManager* out)
   : G4UserEventAction()
   , fOutput(out)
 {
+  fTrigger = new QTEventTrigger();
 }
 
 
-NAEventAction::~NAEventAction() = default;
+NAEventAction::~NAEventAction()
+{
+  delete fTrigger;
+}
 
 
 
@@ -46,11 +72,16 @@ NAEventAction::GetGasHitsCollection(G4int hcID,
 
 void NAEventAction::BeginOfEventAction(const G4Event*
                                          /*event*/)
-{ 
+{
+  fStart = std::chrono::steady_clock::now();
 }
 
 void NAEventAction::EndOfEventAction(const G4Event* event)
 {
+  // tracking done, event cost for the scheduler and tail report
+  QTEventCost::Instance().Record(event->GetEventID(),
+                                 std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fStart).count());
+
   // Get GAS hits collections IDs
   if(fGID < 0) 
     fGID = G4SDManager::GetSDMpointer()->GetCollectionID("GasHitsCollection");
@@ -68,121 +99,92 @@ void NAEventAction::EndOfEventAction(const G4Event* event)
   auto VacHC     = GetGasHitsCollection(fVID, event);
   //  G4cout << "EVENT>>> " << event->GetEventID() << ", number of vacuum stopped hits: " << VacHC->entries() << G4endl;
 
-  // dummy hit storage
-  std::vector<double> tedep, ttime, tkine1, tkine2, px, py, posx, posy, posz;
-  std::vector<int> tid;
-
-  // fill Hits output from SD
-  G4int GnofHits = GasHC->entries();
-  //  G4cout << "EVENT>>> " << event->GetEventID() << ", number of hits: " << GnofHits << G4endl;
+  G4TrajectoryContainer* trajectoryContainer = event->GetTrajectoryContainer();
+  G4int                  n_trajectories =
+    (trajectoryContainer == nullptr) ? 0 : trajectoryContainer->entries();
 
-  // Gas detector
-  for ( G4int i=0; i<GnofHits; i++ ) 
-  {
-    auto hh = dynamic_cast<QTGasHit*>(GasHC->GetHit(i));
-
-    int    id = (hh->GetTrackID());
-    double e  = (hh->GetEdep()) / G4Analysis::GetUnitValue("keV");
-    double tt = (hh->GetTime()) / G4Analysis::GetUnitValue("ns");
-    double k1  = (hh->GetPreKine()) / G4Analysis::GetUnitValue("keV");
-    double k2  = (hh->GetPostKine()) / G4Analysis::GetUnitValue("keV");
-    double mx = (hh->GetPreTheta()); // pitch angle from momentum
-    double my = (hh->GetPostTheta());
-    double lx = (hh->GetPosx()); // interaction location
-    double ly = (hh->GetPosy());
-    double lz = (hh->GetPosz());
-
-    tid.push_back(id);
-    tedep.push_back(e);
-    ttime.push_back(tt);
-    tkine1.push_back(k1);
-    tkine2.push_back(k2);
-    px.push_back(mx);
-    py.push_back(my);
-    posx.push_back(lx);
-    posy.push_back(ly);
-    posz.push_back(lz);
+  // time segmented primary: series of earlier segments go in front,
+  // a stopped primary is held for the next pass and written by its
+  // last segment as a single row from the segment 0 vertex
+  auto*  segment  = dynamic_cast<QTSegmentInfo*>(event->GetUserInformation());
+  NATrajectory* primary = nullptr;
+  NATrajectory* held    = nullptr;
+  if (segment) {
+    for (G4int i=0; i<n_trajectories && !primary; ++i) {
+      auto* trj = static_cast<NATrajectory*>((*trajectoryContainer)[i]);
+      if (trj->GetTrackID() == 1) primary = trj;
+    }
+    QTSegmentStore& store = QTSegmentStore::Instance();
+    QTSegmentStore::Series series;
+    if (primary && segment->GetStart().segment > 0 && store.Release(event->GetEventID(), series))
+      prependColumns(series, primary->getColumns());
+    if (segment->IsStopped()) {
+      store.Push(segment->GetStop());
+      if (primary) {
+        holdColumns(primary->getColumns(), series);
+        store.Hold(event->GetEventID(), series);
+        held = primary;
+      }
+    }
   }
 
-  // Vac stopped e- detector
-  for ( G4int i=0; i<VacHC->entries(); i++ ) 
-  {
-    auto hh = dynamic_cast<QTGasHit*>(VacHC->GetHit(i));
-
-    int    id = (hh->GetTrackID());
-    double tt = (hh->GetTime()) / G4Analysis::GetUnitValue("ns");
-    double lx = (hh->GetPosx()); // interaction location
-    double ly = (hh->GetPosy());
-    double lz = (hh->GetPosz());
-
-    tid.push_back(id);
-    tedep.push_back(0.0);
-    ttime.push_back(tt); // stop time
-    tkine1.push_back(0.0);
-    tkine2.push_back(0.0);
-    px.push_back(0.0);
-    py.push_back(0.0);
-    posx.push_back(lx); // stop location
-    posy.push_back(ly);
-    posz.push_back(lz);
+  // trigger decision before any output; while its primary is held a
+  // segment is kept unfiltered, the primary is decided by its last one
+  G4bool accept = true;
+  if (fTrigger->IsActive() && !held) {
+    accept = false;
+    for (G4int i=0; i<n_trajectories && !accept; ++i) {
+      auto* trj = static_cast<NATrajectory*>((*trajectoryContainer)[i]);
+      // whole primary, vertex window on the segment 0 vertex energy
+      G4double ekin = (trj == primary) ? segment->GetStart().vertexEnergy
+                                       : trj->GetInitialEnergy();
+      accept = fTrigger->Accept(trj->getColumns(), ekin);
+    }
+    if (!accept && !fTrigger->KeepSummary()) return; // drop event
   }
 
-  // fill the ntuple - check column id?
+  // fill Score rows directly from the SD hits, single pass
   G4int eventID = event->GetEventID();
-  for (unsigned int i=0;i<tid.size();i++)
-  {
-    fOutput->FillNtupleI(0, 0, eventID); // repeat all rows
-    fOutput->FillNtupleI(0, 1, tid.at(i));
-    fOutput->FillNtupleD(0, 2, tedep.at(i));
-    fOutput->FillNtupleD(0, 3, ttime.at(i));
-    fOutput->FillNtupleD(0, 4, tkine1.at(i));
-    fOutput->FillNtupleD(0, 5, tkine2.at(i));
-    fOutput->FillNtupleD(0, 6, px.at(i));
-    fOutput->FillNtupleD(0, 7, py.at(i));
-    fOutput->FillNtupleD(0, 8, posx.at(i));
-    fOutput->FillNtupleD(0, 9, posy.at(i));
-    fOutput->FillNtupleD(0, 10, posz.at(i));
-    fOutput->AddNtupleRow(0);
-  }
-  // next fill vectors from trajectory store, i.e. stored G4Steps
+  G4double weight = (event->GetNumberOfPrimaryVertex() > 0)
+    ? event->GetPrimaryVertex()->GetWeight() : 1.0; // importance weight
 
-  G4TrajectoryContainer* trajectoryContainer = event->GetTrajectoryContainer();
-  G4int                  n_trajectories =
-    (trajectoryContainer == nullptr) ? 0 : trajectoryContainer->entries();
+  // Gas detector
+  for (std::size_t i=0; i<GasHC->entries(); ++i)
+    fOutput->AddScoreRow(eventID, weight, (*GasHC)[i]);
+
+  // Vac stopped e- detector
+  for (std::size_t i=0; i<VacHC->entries(); ++i)
+    fOutput->AddStopRow(eventID, weight, (*VacHC)[i]);
+
+  // next fill vectors from trajectory store, i.e. stored G4Steps
 
   //  G4cout << "PRINT>>> number of trajectories: " << n_trajectories << G4endl;
   
   if(n_trajectories > 0) {
     for(auto* entry : *(trajectoryContainer->GetVector())) {  // vector<G4VTrajectory*>*
-      NATrajectory* trj = dynamic_cast<NATrajectory*>(entry);
-      G4int counter = 0;
-      for (auto value : trj->getOm()) {
- 	fOutput->FillOmVec(value);
- 	fOutput->FillKEVec(trj->getKE().at(counter) / G4Analysis::GetUnitValue("keV"));
-	fOutput->FillTimeVec((trj->getTime()).at(counter));
-	fOutput->FillXVec((trj->getXpos()).at(counter) / G4Analysis::GetUnitValue("m"));
-	fOutput->FillYVec((trj->getYpos()).at(counter) / G4Analysis::GetUnitValue("m"));
-	fOutput->FillZVec((trj->getZpos()).at(counter) / G4Analysis::GetUnitValue("m"));
-	fOutput->FillBetaXVec((trj->getBetaX()).at(counter));
-	fOutput->FillBetaYVec((trj->getBetaY()).at(counter));
-	fOutput->FillBetaZVec((trj->getBetaZ()).at(counter));
-	fOutput->FillAccXVec((trj->getAccX()).at(counter));
-	fOutput->FillAccYVec((trj->getAccY()).at(counter));
-	fOutput->FillAccZVec((trj->getAccZ()).at(counter));
-	counter++;
-      }
+      auto* trj = static_cast<NATrajectory*>(entry); // only our trajectories stored
+      if (trj == held) continue; // row with its last segment
+      if (accept) fOutput->FillSignalColumns(trj->getColumns()); // zero-copy
+      // else summary row, empty time series
         
       // fill the ntuple, n antenna data for each trajectory
       fOutput->FillNtupleI(1, 0, eventID); // repeat all rows
       fOutput->FillNtupleI(1, 1, trj->GetTrackID()); // trajectory specific
       // vertex info first in row
-      G4ThreeVector p = trj->GetInitialPosition();
+      G4ThreeVector p    = trj->GetInitialPosition();
+      G4ThreeVector mom  = trj->GetInitialMomentum();
+      G4double      ekin = trj->GetInitialEnergy();
+      if (trj == primary) { // whole primary, segment 0 vertex
+        p    = segment->GetStart().vertexPosition;
+        mom  = segment->GetStart().vertexDirection;
+        ekin = segment->GetStart().vertexEnergy;
+      }
       fOutput->FillNtupleD(1, 2, p.x()); // [mm] default
       fOutput->FillNtupleD(1, 3, p.y());
       fOutput->FillNtupleD(1, 4, p.z());
-      G4ThreeVector mom = trj->GetInitialMomentum();
       fOutput->FillNtupleD(1, 5, mom.theta()); // angle to z-axis
-      fOutput->FillNtupleD(1, 6, trj->GetInitialEnergy() / G4Analysis::GetUnitValue("keV"));
+      fOutput->FillNtupleD(1, 6, ekin / keV);
+      fOutput->FillNtupleD(1, 7, weight);
       
       // Note no need to call FillNtupleDColumn for vector types
       // Filled automatically on call to AddNtupleRow
@@ -1,6 +1,9 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 #include "NAOutputManager.hh"
+#include "QTGasHit.hh"
+#include "QTHdf5Manager.hh"
+#include "QTSegmentStore.hh"
 
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
@@ -14,15 +17,47 @@ NAOutputManager::NAOutputManager(G4String fname)
   // Create or get analysis manager
   analysisManager = G4AnalysisManager::Instance();
   analysisManager->SetDefaultFileType("root");
+
+  // columnar output selected by file extension
+  if (QTHdf5Manager::IsHdf5FileName(fout)) hdf5Manager = new QTHdf5Manager();
 }
 
 // leave deleting to run manager, follows AnaEx01
 
-NAOutputManager::~NAOutputManager() = default;
+NAOutputManager::~NAOutputManager()
+{
+  delete hdf5Manager;
+}
+
+
+inline void NAOutputManager::FillI(G4int which, G4int col, G4int val)
+{
+  if (hdf5Manager) hdf5Manager->FillNtupleIColumn(which, col, val);
+  else             analysisManager->FillNtupleIColumn(which, col, val);
+}
+
+
+inline void NAOutputManager::FillD(G4int which, G4int col, G4double val)
+{
+  if (hdf5Manager) hdf5Manager->FillNtupleDColumn(which, col, val);
+  else             analysisManager->FillNtupleDColumn(which, col, val);
+}
+
+
+inline void NAOutputManager::AddRow(G4int which)
+{
+  if (hdf5Manager) hdf5Manager->AddNtupleRow(which);
+  else             analysisManager->AddNtupleRow(which);
+}
 
 
 void NAOutputManager::Book()
 {
+  if (hdf5Manager) { // columnar HDF5 output
+    BookNtuples(hdf5Manager);
+    return;
+  }
+
   // Create or get analysis manager
   analysisManager = G4AnalysisManager::Instance();
 
@@ -34,9 +69,16 @@ void NAOutputManager::Book()
     analysisManager->SetNtupleDirectoryName("ntuple");
   }
 
-  // Open an output file
+  BookNtuples(analysisManager);
+}
+
+
+template <class M>
+void NAOutputManager::BookNtuples(M* mgr)
+{
+  // Open an output file, one per segment pass
   //
-  G4bool fileOpen = analysisManager->OpenFile(fout);
+  G4bool fileOpen = mgr->OpenFile(QTSegmentStore::Instance().PassFileName(fout));
   if (! fileOpen) {
     G4cerr << "\n---> OutputManager::Book(): cannot open "
            << GetFileName() << G4endl;
@@ -49,57 +91,42 @@ void NAOutputManager::Book()
     
     // Creating ntuple 0 with number entries
     //
-    analysisManager->CreateNtuple("Score", "Hits");
-    analysisManager->CreateNtupleIColumn("EventID");
-    analysisManager->CreateNtupleIColumn("TrackID");
-    analysisManager->CreateNtupleDColumn("Edep");
-    analysisManager->CreateNtupleDColumn("TimeStamp");
-    analysisManager->CreateNtupleDColumn("PreKine");
-    analysisManager->CreateNtupleDColumn("PostKine");
-    analysisManager->CreateNtupleDColumn("PreTheta");
-    analysisManager->CreateNtupleDColumn("PostTheta");
-    analysisManager->CreateNtupleDColumn("Posx");
-    analysisManager->CreateNtupleDColumn("Posy");
-    analysisManager->CreateNtupleDColumn("Posz");
-    analysisManager->FinishNtuple();
+    mgr->CreateNtuple("Score", "Hits");
+    mgr->CreateNtupleIColumn("EventID");
+    mgr->CreateNtupleIColumn("TrackID");
+    mgr->CreateNtupleDColumn("Edep");
+    mgr->CreateNtupleDColumn("TimeStamp");
+    mgr->CreateNtupleDColumn("PreKine");
+    mgr->CreateNtupleDColumn("PostKine");
+    mgr->CreateNtupleDColumn("PreTheta");
+    mgr->CreateNtupleDColumn("PostTheta");
+    mgr->CreateNtupleDColumn("Posx");
+    mgr->CreateNtupleDColumn("Posy");
+    mgr->CreateNtupleDColumn("Posz");
+    mgr->CreateNtupleDColumn("Weight"); // event weight
+    mgr->FinishNtuple();
     
     // Creating ntuple 1 with vector entries
-    //
-    G4String ovecname = "OmVec";
-    G4String kvecname = "KEVec";
-    G4String tvecname = "SourceTime";
-    G4String xpname = "PosxVec";
-    G4String ypname = "PosyVec";
-    G4String zpname = "PoszVec";
-    G4String bxname = "BetaxVec";
-    G4String byname = "BetayVec";
-    G4String bzname = "BetazVec";
-    G4String axname = "AccxVec";
-    G4String ayname = "AccyVec";
-    G4String azname = "AcczVec";
-    analysisManager->CreateNtuple("Signal", "Time-series");
-    analysisManager->CreateNtupleIColumn("EventID");
-    analysisManager->CreateNtupleIColumn("TrackID");
-    analysisManager->CreateNtupleDColumn("Posx"); // single starter values
-    analysisManager->CreateNtupleDColumn("Posy"); // for each trajectory
-    analysisManager->CreateNtupleDColumn("Posz"); // vertex position and
-    analysisManager->CreateNtupleDColumn("PitchAngle"); // pitch angle wrt z-axis
-    analysisManager->CreateNtupleDColumn("KinEnergy"); // kinetic energy
+    // names in NAColumnStore column order
+    const std::array<G4String, NAColumnStore::kNColumns> vecnames =
+      {"OmVec", "KEVec", "SourceTime",
+       "PosxVec", "PosyVec", "PoszVec",
+       "BetaxVec", "BetayVec", "BetazVec",
+       "AccxVec", "AccyVec", "AcczVec"};
+    mgr->CreateNtuple("Signal", "Time-series");
+    mgr->CreateNtupleIColumn("EventID");
+    mgr->CreateNtupleIColumn("TrackID");
+    mgr->CreateNtupleDColumn("Posx"); // single starter values
+    mgr->CreateNtupleDColumn("Posy"); // for each trajectory
+    mgr->CreateNtupleDColumn("Posz"); // vertex position and
+    mgr->CreateNtupleDColumn("PitchAngle"); // pitch angle wrt z-axis
+    mgr->CreateNtupleDColumn("KinEnergy"); // kinetic energy
+    mgr->CreateNtupleDColumn("Weight"); // event weight
     // These need passing a reference to the vector
     // filled by AddNtupleRow() assumed
-    analysisManager->CreateNtupleDColumn(ovecname, GetOmVec());
-    analysisManager->CreateNtupleDColumn(kvecname, GetKEVec());
-    analysisManager->CreateNtupleDColumn(tvecname, GetTimeVec());
-    analysisManager->CreateNtupleDColumn(xpname, GetXVec());
-    analysisManager->CreateNtupleDColumn(ypname, GetYVec());
-    analysisManager->CreateNtupleDColumn(zpname, GetZVec());
-    analysisManager->CreateNtupleDColumn(bxname, GetBetaXVec());
-    analysisManager->CreateNtupleDColumn(byname, GetBetaYVec());
-    analysisManager->CreateNtupleDColumn(bzname, GetBetaZVec());
-    analysisManager->CreateNtupleDColumn(axname, GetAccXVec());
-    analysisManager->CreateNtupleDColumn(ayname, GetAccYVec());
-    analysisManager->CreateNtupleDColumn(azname, GetAccZVec());
-    analysisManager->FinishNtuple();
+    for (G4int c = 0; c < NAColumnStore::kNColumns; ++c)
+      mgr->CreateNtupleDColumn(vecnames[c], fSignal[c]);
+    mgr->FinishNtuple();
 
     fFactoryOn = true;
   }
@@ -108,11 +135,18 @@ void NAOutputManager::Book()
 
 void NAOutputManager::Save()
 {
+  if (! fFactoryOn) { return; }
+
+  if (hdf5Manager) {
+    hdf5Manager->Write();
+    hdf5Manager->CloseFile();
+    hdf5Manager->Clear();
+    return;
+  }
+
   // Create or get analysis manager
   analysisManager = G4AnalysisManager::Instance();
 
-  if (! fFactoryOn) { return; }
-  
   analysisManager->Write();
   analysisManager->CloseFile();
   analysisManager->Clear();
@@ -121,40 +155,66 @@ void NAOutputManager::Save()
 
 void NAOutputManager::FillNtupleI(G4int which, G4int col, G4int val)
 {
-  // Create or get analysis manager
-  analysisManager = G4AnalysisManager::Instance();
-
-  analysisManager->FillNtupleIColumn(which, col, val);
+  FillI(which, col, val);
 }
 
 
 void NAOutputManager::FillNtupleD(G4int which, G4int col, G4double val)
 {
-  // Create or get analysis manager
-  analysisManager = G4AnalysisManager::Instance();
+  FillD(which, col, val);
+}
+
 
-  analysisManager->FillNtupleDColumn(which, col, val);
+void NAOutputManager::FillSignalColumns(NAColumnStore* store)
+{
+  // exchange buffers with the booked vectors; references held by
+  // the ntuple stay valid. Store receives the cleared buffers.
+  for (G4int c = 0; c < NAColumnStore::kNColumns; ++c)
+    fSignal[c].swap(store->GetColumn(c));
 }
 
 
-void NAOutputManager::AddNtupleRow(G4int which)
+void NAOutputManager::AddScoreRow(G4int eventID, G4double weight, const QTGasHit* hit)
 {
-  // Create or get analysis manager
-  analysisManager = G4AnalysisManager::Instance();
+  FillI(fScoreID, kEventID, eventID);
+  FillI(fScoreID, kTrackID, hit->GetTrackID());
+  FillD(fScoreID, kEdep, hit->GetEdep() * fPerkeV);
+  FillD(fScoreID, kTimeStamp, hit->GetTime() * fPerns);
+  FillD(fScoreID, kPreKine, hit->GetPreKine() * fPerkeV);
+  FillD(fScoreID, kPostKine, hit->GetPostKine() * fPerkeV);
+  FillD(fScoreID, kPreTheta, hit->GetPreTheta()); // pitch angle
+  FillD(fScoreID, kPostTheta, hit->GetPostTheta());
+  FillD(fScoreID, kPosx, hit->GetPosx()); // interaction location
+  FillD(fScoreID, kPosy, hit->GetPosy());
+  FillD(fScoreID, kPosz, hit->GetPosz());
+  FillD(fScoreID, kWeight, weight);
+  AddRow(fScoreID);
+}
+
 
-  analysisManager->AddNtupleRow(which);
+void NAOutputManager::AddStopRow(G4int eventID, G4double weight, const QTGasHit* hit)
+{
+  // stop time and location only
+  FillI(fScoreID, kEventID, eventID);
+  FillI(fScoreID, kTrackID, hit->GetTrackID());
+  FillD(fScoreID, kEdep, 0.0);
+  FillD(fScoreID, kTimeStamp, hit->GetTime() * fPerns);
+  FillD(fScoreID, kPreKine, 0.0);
+  FillD(fScoreID, kPostKine, 0.0);
+  FillD(fScoreID, kPreTheta, 0.0);
+  FillD(fScoreID, kPostTheta, 0.0);
+  FillD(fScoreID, kPosx, hit->GetPosx());
+  FillD(fScoreID, kPosy, hit->GetPosy());
+  FillD(fScoreID, kPosz, hit->GetPosz());
+  FillD(fScoreID, kWeight, weight);
+  AddRow(fScoreID);
+}
+
+
+void NAOutputManager::AddNtupleRow(G4int which)
+{
+  AddRow(which);
 
   // clear internal vector storage after writing to disk with this method.
-  tvec.clear();
-  kvec.clear();
-  ovec.clear();
-  xvec.clear();
-  yvec.clear();
-  zvec.clear();
-  bxvec.clear();
-  byvec.clear();
-  bzvec.clear();
-  axvec.clear();
-  ayvec.clear();
-  azvec.clear();
+  for (auto& col : fSignal) col.clear();
 }
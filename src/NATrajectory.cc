@@ -28,6 +28,7 @@ NATrajectory::NATrajectory(const G4Track* aTrack)
 , fTrackID(aTrack->GetTrackID())
 , fParentID(aTrack->GetParentID())
 , initialMomentum(aTrack->GetMomentum())
+, fColumns(QTStorePool<NAColumnStore>::Acquire()) // from thread-local pool
 {
   // set up information retrieval from singletons
   pfieldManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
@@ -42,18 +43,7 @@ NATrajectory::NATrajectory(const G4Track* aTrack)
 
 NATrajectory::~NATrajectory()
 {
-  fOm.clear();
-  fKE.clear();
-  ft.clear();
-  xp.clear();
-  yp.clear();
-  zp.clear();
-  betax.clear();
-  betay.clear();
-  betaz.clear();
-  accx.clear();
-  accy.clear();
-  accz.clear();
+  QTStorePool<NAColumnStore>::Release(fColumns); // back to pool, keeps capacity
 }
 
 void NATrajectory::AppendStep(const G4Step* aStep)
@@ -81,18 +71,13 @@ void NATrajectory::AppendStep(const G4Step* aStep)
   acc = getAcceleration();
   
 
-  fOm.push_back(getOmega().mag()); // angular frequency magnitude
-  fKE.push_back(aStep->GetPostStepPoint()->GetKineticEnergy());
-  ft.push_back(gltime);
-  xp.push_back(pos.x());
-  yp.push_back(pos.y());
-  zp.push_back(pos.z());
-  betax.push_back(beta.x());
-  betay.push_back(beta.y());
-  betaz.push_back(beta.z());
-  accx.push_back(acc.x());
-  accy.push_back(acc.y());
-  accz.push_back(acc.z());
+  // one row, stored in output units [keV], [ns], [m]
+  fColumns->Append({getOmega().mag(), // angular frequency magnitude
+		    aStep->GetPostStepPoint()->GetKineticEnergy() / keV,
+		    gltime,
+		    pos.x() / m, pos.y() / m, pos.z() / m,
+		    beta.x(), beta.y(), beta.z(),
+		    acc.x(), acc.y(), acc.z()});
 }
 
 G4ThreeVector NATrajectory::getOmega()
@@ -8,12 +8,16 @@
 #include "NATrackingAction.hh"
 #include "QTOutputManager.hh"
 #include "NAOutputManager.hh"
+#include "QTSegmentAction.hh"
+#include "QTSegmentStore.hh"
 
 
-QTActionInitialization::QTActionInitialization(G4String name, std::vector<G4double> ang)
+QTActionInitialization::QTActionInitialization(G4String name, std::vector<G4double> ang,
+					       G4int firstEvent)
 : G4VUserActionInitialization()
 , foutname(std::move(name))
 , angles(std::move(ang))
+, ffirst(firstEvent)
 {}
 
 QTActionInitialization::~QTActionInitialization() = default;
@@ -33,7 +37,7 @@ void QTActionInitialization::BuildForMaster() const
 void QTActionInitialization::Build() const
 {
   // forward detector
-  SetUserAction(new QTPrimaryGeneratorAction());
+  SetUserAction(new QTPrimaryGeneratorAction(ffirst));
 
   if (angles.empty()) { // noAntenna simulation case
     SetUserAction(new NATrackingAction());
@@ -47,4 +51,8 @@ void QTActionInitialization::Build() const
     SetUserAction(new QTEventAction(output));
     SetUserAction(new QTRunAction(output));
   }
+
+  // time segmented primaries, continued in later passes
+  if (QTSegmentStore::Instance().IsActive())
+    SetUserAction(new QTSegmentAction(QTSegmentStore::Instance().GetLength()));
 }
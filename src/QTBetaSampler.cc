@@ -0,0 +1,294 @@
+#include "QTBetaSampler.hh"
+#include "TBetaGenerator.hh"
+
+#include "G4AutoLock.hh"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <thread>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+  G4Mutex mySamplerLock = G4MUTEX_INITIALIZER;
+
+  // table file layout: header, density[nbins+1], prob[nbins], alias[nbins]
+  struct TableHeader {
+    char         magic[8];
+    std::int32_t version;
+    std::int32_t nbins;
+    std::int32_t order;
+    std::int32_t intsize;
+    std::int32_t full;
+    std::int32_t reserved;
+    double       numass;
+    double       sterilemass;
+    double       mixing;
+    double       emin;
+    double       emax;
+    double       biasFactor;
+    double       biasWidth;
+  };
+  static_assert(sizeof(TableHeader) == 88, "no padding in table header");
+  constexpr char         tableMagic[8] = "QTBETA";
+  constexpr std::int32_t tableVersion  = 4;
+
+  TableHeader makeHeader(const QTBetaSampler::Parameters& par)
+  {
+    TableHeader h{};
+    std::memcpy(h.magic, tableMagic, sizeof(h.magic));
+    h.version     = tableVersion;
+    h.nbins       = par.nbins;
+    h.order       = par.order ? 1 : 0;
+    h.intsize     = sizeof(G4int);
+    h.full        = par.full ? 1 : 0;
+    h.numass      = par.numass;
+    h.sterilemass = par.sterilemass;
+    h.mixing      = par.mixing;
+    h.emin        = par.emin;
+    h.emax        = par.emax;
+    h.biasFactor  = par.biasFactor;
+    h.biasWidth   = par.biasWidth;
+    return h;
+  }
+
+  std::size_t tableSize(G4int nbins)
+  {
+    return sizeof(TableHeader) + (2*nbins + 1)*sizeof(G4double) + nbins*sizeof(G4int);
+  }
+}
+
+
+std::shared_ptr<const QTBetaSampler> QTBetaSampler::Get(const Parameters& par,
+							const G4String& cacheDir)
+{
+  // cache holds no ownership, unused tables are released
+  static std::map<Parameters, std::weak_ptr<const QTBetaSampler>> cache;
+
+  G4AutoLock lock(&mySamplerLock); // other threads wait for the same table
+  auto& entry = cache[par];
+  std::shared_ptr<const QTBetaSampler> sampler = entry.lock();
+  if (!sampler) {
+    sampler = std::shared_ptr<const QTBetaSampler>(new QTBetaSampler(par, cacheDir));
+    entry   = sampler;
+  }
+  return sampler;
+}
+
+
+QTBetaSampler::QTBetaSampler(const Parameters& par, const G4String& cacheDir)
+: fPar(par)
+, fWidth(0.0)
+{
+  if (fPar.nbins < 1 || fPar.emax <= fPar.emin) {
+    G4ExceptionDescription msg;
+    msg << "Invalid beta spectrum interval [" << fPar.emin << ", "
+	<< fPar.emax << "] keV with " << fPar.nbins << " bins.";
+    G4Exception("QTBetaSampler::QTBetaSampler()", "QTBeta001", FatalException, msg);
+  }
+  if (fPar.biasFactor < 0.0 || (fPar.biasFactor > 0.0 && fPar.biasWidth <= 0.0)) {
+    G4ExceptionDescription msg;
+    msg << "Invalid endpoint bias factor " << fPar.biasFactor
+	<< " with width " << fPar.biasWidth << " keV.";
+    G4Exception("QTBetaSampler::QTBetaSampler()", "QTBeta004", FatalException, msg);
+  }
+  fWidth = (fPar.emax - fPar.emin) / fPar.nbins;
+
+  G4String fname = cacheDir.empty() ? "" : FileName(cacheDir);
+  if (fname.empty() || !Load(fname)) {
+    Tabulate();
+    BuildAlias();
+    if (!fname.empty()) Save(fname);
+  }
+
+  if (fPar.biasFactor > 0.0) {
+    // trapezoid integrals of biased and unbiased density
+    G4double sumq = 0.0;
+    G4double sump = 0.0;
+    for (G4int i=0; i<=fPar.nbins; ++i) {
+      G4double f = (i==0 || i==fPar.nbins) ? 0.5 : 1.0;
+      sumq += f*fDensity[i];
+      sump += f*fDensity[i] / Bias(fPar.emin + i*fWidth);
+    }
+    fBiasNorm = sumq / sump;
+  }
+}
+
+
+G4double QTBetaSampler::Bias(G4double e) const
+{
+  if (fPar.biasFactor <= 0.0) return 1.0;
+  return 1.0 + fPar.biasFactor*std::exp(-(fPar.emax - e)/fPar.biasWidth);
+}
+
+
+QTBetaSampler::~QTBetaSampler()
+{
+  if (fMap) munmap(fMap, fMapSize);
+}
+
+
+G4String QTBetaSampler::FileName(const G4String& cacheDir) const
+{
+  // FNV-1a over the header, i.e. all parameters
+  TableHeader h = makeHeader(fPar);
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&h);
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (std::size_t i=0; i<sizeof(h); ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  char name[32];
+  std::snprintf(name, sizeof(name), "beta_%016llx.tab", (unsigned long long)hash);
+  return cacheDir + "/" + name;
+}
+
+
+G4bool QTBetaSampler::Load(const G4String& fname)
+{
+  int fd = open(fname.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  std::size_t size = tableSize(fPar.nbins);
+  void* map = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && (std::size_t)st.st_size == size)
+    map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) return false;
+
+  // hash collision or stale format: rebuild
+  TableHeader h = makeHeader(fPar);
+  if (std::memcmp(map, &h, sizeof(h)) != 0) {
+    munmap(map, size);
+    return false;
+  }
+  fMap     = map;
+  fMapSize = size;
+  const char* data = static_cast<const char*>(map) + sizeof(TableHeader);
+  fDensity = reinterpret_cast<const G4double*>(data);
+  fProb    = fDensity + fPar.nbins + 1;
+  fAlias   = reinterpret_cast<const G4int*>(fProb + fPar.nbins);
+  return true;
+}
+
+
+void QTBetaSampler::Save(const G4String& fname) const
+{
+  // write aside and rename, concurrent jobs never see partial files
+  G4String tmpname = fname + ".tmp" + std::to_string(getpid());
+  std::ofstream out(tmpname, std::ios::binary);
+  TableHeader h = makeHeader(fPar);
+  out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+  out.write(reinterpret_cast<const char*>(fDensity), (fPar.nbins + 1)*sizeof(G4double));
+  out.write(reinterpret_cast<const char*>(fProb), fPar.nbins*sizeof(G4double));
+  out.write(reinterpret_cast<const char*>(fAlias), fPar.nbins*sizeof(G4int));
+  out.close();
+
+  if (!out || std::rename(tmpname.c_str(), fname.c_str()) != 0) {
+    std::remove(tmpname.c_str());
+    G4ExceptionDescription msg;
+    msg << "Cannot write beta spectrum table " << fname << ", not cached.";
+    G4Exception("QTBetaSampler::Save()", "QTBeta003", JustWarning, msg);
+  }
+}
+
+
+void QTBetaSampler::Tabulate()
+{
+  // nodes are independent, contiguous blocks over hardware threads,
+  // batch evaluation within a block
+  G4int nodes    = fPar.nbins + 1;
+  G4int nthreads = std::max(1, std::min((G4int)std::thread::hardware_concurrency(),
+					nodes / 1000));
+  std::vector<G4double> energy(nodes);
+  for (G4int k=0; k<nodes; ++k) energy[k] = fPar.emin + k*fWidth;
+  fDensityBuf.resize(nodes);
+
+  auto tabulate = [this, &energy, nodes, nthreads](G4int id) {
+    G4int first = (G4int)((G4long)nodes*id/nthreads);
+    G4int last  = (G4int)((G4long)nodes*(id+1)/nthreads);
+    if (fPar.full)
+      TBeta::dGammadEFull(fPar.order, fPar.numass, fPar.sterilemass, fPar.mixing,
+			  &energy[first], &fDensityBuf[first], last-first);
+    else
+      TBeta::dGammadE(fPar.order, fPar.numass, fPar.sterilemass, fPar.mixing,
+		      &energy[first], &fDensityBuf[first], last-first);
+    for (G4int k=first; k<last; ++k) {
+      if (!(fDensityBuf[k] > 0.0)) fDensityBuf[k] = 0.0; // also catches NaN
+      fDensityBuf[k] *= Bias(energy[k]);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (G4int id=1; id<nthreads; ++id) workers.emplace_back(tabulate, id);
+  tabulate(0);
+  for (auto& w : workers) w.join();
+  fDensity = fDensityBuf.data();
+}
+
+
+void QTBetaSampler::BuildAlias()
+{
+  // Vose alias method on trapezoid bin areas
+  G4int n = fPar.nbins;
+  std::vector<G4double> p(n);
+  G4double total = 0.0;
+  for (G4int i=0; i<n; ++i) {
+    p[i]   = 0.5 * (fDensity[i] + fDensity[i+1]);
+    total += p[i];
+  }
+  if (total <= 0.0) {
+    G4ExceptionDescription msg;
+    msg << "Beta spectrum vanishes in [" << fPar.emin << ", " << fPar.emax << "] keV.";
+    G4Exception("QTBetaSampler::BuildAlias()", "QTBeta002", FatalException, msg);
+  }
+
+  fProbBuf.assign(n, 1.0);
+  fAliasBuf.resize(n);
+  std::vector<G4int> small, large;
+  for (G4int i=0; i<n; ++i) {
+    fAliasBuf[i] = i;
+    p[i] *= n / total;
+    if (p[i] < 1.0) small.push_back(i);
+    else            large.push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    G4int s = small.back(); small.pop_back();
+    G4int l = large.back();
+    fProbBuf[s]  = p[s];
+    fAliasBuf[s] = l;
+    p[l] -= 1.0 - p[s];
+    if (p[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // leftovers have probability 1 up to rounding, keep fProb=1
+  fProb  = fProbBuf.data();
+  fAlias = fAliasBuf.data();
+}
+
+
+G4double QTBetaSampler::Sample(G4double u1, G4double u2) const
+{
+  G4double x = u1 * fPar.nbins;
+  G4int    i = std::min((G4int)x, fPar.nbins - 1);
+  if (x - i >= fProb[i]) i = fAlias[i];
+
+  // invert linear density w0 + (w1-w0)t on t in [0,1], stable form
+  G4double w0    = fDensity[i];
+  G4double w1    = fDensity[i+1];
+  G4double denom = w0 + std::sqrt(w0*w0 + (w1*w1 - w0*w0)*u2);
+  G4double t     = (denom > 0.0) ? u2*(w0 + w1)/denom : u2;
+  return fPar.emin + (i + t)*fWidth;
+}
@@ -0,0 +1,35 @@
+#include "QTColumnStore.hh"
+
+#include <algorithm>
+
+
+void QTColumnStore::Clear()
+{
+  // columns may have been swapped with the output manager vectors
+  fOm.clear();
+  fKE.clear();
+  fST.clear();
+  fAntennaID.clear();
+  fTime.clear();
+  fVoltage.clear();
+  fStepCapacity   = std::min({fOm.capacity(), fKE.capacity(), fST.capacity()});
+  fSignalCapacity = std::min({fAntennaID.capacity(), fTime.capacity(), fVoltage.capacity()});
+}
+
+
+void QTColumnStore::GrowStep()
+{
+  fStepCapacity = std::max(fInitialRows, 2*fStepCapacity);
+  fOm.reserve(fStepCapacity);
+  fKE.reserve(fStepCapacity);
+  fST.reserve(fStepCapacity);
+}
+
+
+void QTColumnStore::GrowSignal()
+{
+  fSignalCapacity = std::max(fInitialRows, 2*fSignalCapacity);
+  fAntennaID.reserve(fSignalCapacity);
+  fTime.reserve(fSignalCapacity);
+  fVoltage.reserve(fSignalCapacity);
+}
@@ -0,0 +1,140 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTEventCost
+//
+// Creation date: 2026
+//
+// -------------------------------------------------------------------
+
+#include "QTEventCost.hh"
+#include "QTSegmentStore.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <numeric>
+
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+
+QTEventCost& QTEventCost::Instance()
+{
+  static QTEventCost cost;
+  return cost;
+}
+
+
+void QTEventCost::SetFileName(const std::string& name)
+{
+  fFileName = name;
+  std::ifstream in(name);
+  G4int    id;
+  G4double seconds;
+  while (in >> id >> seconds) fCost[id] = seconds;
+  if (!fCost.empty())
+    G4cout << "QTEventCost: " << fCost.size() << " event costs from " << name << G4endl;
+}
+
+
+void QTEventCost::BeginRun(G4int nEvents)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fThreads.clear();
+  fRun.clear();
+  fOrder.clear();
+  fStart = Clock::now();
+  if (nEvents < 2) return;
+
+  // event IDs of the run, unknown costs at the mean of the known ones
+  const QTSegmentStore& segments = QTSegmentStore::Instance();
+  std::vector<G4double> cost(nEvents, -1.0);
+  G4double sum   = 0.0;
+  G4int    known = 0;
+  const G4bool pass = (segments.GetPass() > 0);
+  const auto&  known_cost = pass ? fSegmentCost : fCost;
+  for (G4int i = 0; i < nEvents; ++i) {
+    G4int id = pass ? segments.GetPending(i).eventID : fFirstEvent + i;
+    auto  it = known_cost.find(id);
+    if (it == known_cost.end()) continue;
+    cost[i] = it->second;
+    sum    += it->second;
+    ++known;
+  }
+  if (known == 0) return;
+  for (G4double& c : cost)
+    if (c < 0.0) c = sum/known;
+
+  // longest first, ties in event order
+  fOrder.resize(nEvents);
+  std::iota(fOrder.begin(), fOrder.end(), 0);
+  std::stable_sort(fOrder.begin(), fOrder.end(),
+		   [&cost](G4int a, G4int b) { return cost[a] > cost[b]; });
+}
+
+
+void QTEventCost::Record(G4int eventID, G4double seconds)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  ThreadStats& t = fThreads[G4Threading::G4GetThreadId()];
+  t.busy += seconds;
+  ++t.events;
+  t.last = Clock::now();
+  fRun.emplace_back(seconds, eventID);
+}
+
+
+void QTEventCost::EndRun()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (fRun.empty()) return;
+  // segments of a pass add to the cost of their event
+  const G4bool pass = (QTSegmentStore::Instance().GetPass() > 0);
+  for (const auto& e : fRun) {
+    fCost[e.second]        = pass ? fCost[e.second] + e.first : e.first;
+    fSegmentCost[e.second] = e.first;
+  }
+
+  auto since = [this](Clock::time_point t) {
+    return std::chrono::duration<G4double>(t - fStart).count();
+  };
+  const G4double wall = since(Clock::now());
+  G4double busy = 0.0;
+  G4double firstIdle = wall, lastDone = 0.0;
+  for (const auto& t : fThreads) {
+    busy     += t.second.busy;
+    firstIdle = std::min(firstIdle, since(t.second.last));
+    lastDone  = std::max(lastDone, since(t.second.last));
+  }
+  const G4int nThreads = (G4int)fThreads.size();
+
+  G4cout << "Event scheduling: " << fRun.size() << " events on " << nThreads << " threads, "
+	 << (fOrder.empty() ? "event order" : "longest first") << G4endl;
+  G4cout << "  wall " << wall << " s, busy " << busy << " s, "
+	 << 100.0*busy/(nThreads*std::max(wall, 1e-9)) << " % of threads" << G4endl;
+  G4cout << "  tail " << lastDone - firstIdle << " s: first thread idle after "
+	 << firstIdle << " s, last done after " << lastDone << " s" << G4endl;
+
+  const std::size_t nShow = std::min<std::size_t>(5, fRun.size());
+  std::partial_sort(fRun.begin(), fRun.begin() + nShow, fRun.end(),
+		    std::greater<std::pair<G4double, G4int>>());
+  G4cout << "  slowest events:";
+  for (std::size_t i = 0; i < nShow; ++i)
+    G4cout << " " << fRun[i].second << " (" << fRun[i].first << " s)";
+  G4cout << G4endl;
+
+  if (!fFileName.empty()) save();
+}
+
+
+void QTEventCost::save() const
+{
+  std::vector<std::pair<G4int, G4double>> rows(fCost.begin(), fCost.end());
+  std::sort(rows.begin(), rows.end());
+  std::ofstream out(fFileName);
+  for (const auto& r : rows) out << r.first << " " << r.second << "\n";
+  if (!out)
+    G4cerr << "QTEventCost: cannot write " << fFileName << G4endl;
+}
@@ -0,0 +1,140 @@
+#include "QTEventTrigger.hh"
+#include "QTColumnStore.hh"
+#include "NAColumnStore.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+
+namespace {
+  // Larmor power [W] = tau * a^2, acceleration in [m/s^2]
+  constexpr G4double c_SI    = c_light/(m/s);
+  constexpr G4double eps0_SI = epsilon0/(farad/m);
+  constexpr G4double tau_SI  = e_SI*e_SI/(6.0*pi*eps0_SI*c_SI*c_SI*c_SI);
+}
+
+
+QTEventTrigger::QTEventTrigger()
+: fActive(false)
+, fSummary(false)
+, fMinTrapTime(0.0)
+, fMinPower(0.0)
+, fBandLow(0.0)
+, fBandHigh(DBL_MAX)
+, fEmin(0.0)
+, fEmax(DBL_MAX)
+{
+  DefineCommands();
+}
+
+
+QTEventTrigger::~QTEventTrigger()
+{
+  delete fMessenger;
+}
+
+
+G4bool QTEventTrigger::InBand(G4double omega) const
+{
+  G4double freq = omega / twopi * hertz; // Omega in [rad/s]
+  return freq >= fBandLow && freq <= fBandHigh;
+}
+
+
+G4bool QTEventTrigger::Accept(QTColumnStore* cols, G4double ekin) const
+{
+  if (!InWindow(ekin)) return false;
+
+  const auto& st = cols->GetST(); // [ns]
+  if (st.empty()) return false;
+  if ((st.back() - st.front())*ns < fMinTrapTime) return false;
+
+  if (fMinPower <= 0.0) return true;
+
+  // antenna samples follow their step, nant per step
+  const auto& om = cols->GetOm();
+  const auto& vt = cols->GetVoltage();
+  std::size_t nant = vt.size() / om.size();
+  if (nant == 0) return false;
+
+  G4double sum = 0.0;
+  std::size_t count = 0;
+  for (std::size_t i=0; i<om.size(); ++i) {
+    if (!InBand(om[i])) continue;
+    for (std::size_t k=i*nant; k<(i+1)*nant; ++k) sum += vt[k]*vt[k];
+    count += nant;
+  }
+  return count > 0 && sum/count >= fMinPower;
+}
+
+
+G4bool QTEventTrigger::Accept(NAColumnStore* cols, G4double ekin) const
+{
+  if (!InWindow(ekin)) return false;
+
+  const auto& st = cols->GetColumn(NAColumnStore::kTime); // [ns]
+  if (st.empty()) return false;
+  if ((st.back() - st.front())*ns < fMinTrapTime) return false;
+
+  if (fMinPower <= 0.0) return true;
+
+  const auto& om = cols->GetColumn(NAColumnStore::kOm);
+  const auto& ax = cols->GetColumn(NAColumnStore::kAccx);
+  const auto& ay = cols->GetColumn(NAColumnStore::kAccy);
+  const auto& az = cols->GetColumn(NAColumnStore::kAccz);
+
+  G4double sum = 0.0;
+  std::size_t count = 0;
+  for (std::size_t i=0; i<om.size(); ++i) {
+    if (!InBand(om[i])) continue;
+    sum += tau_SI * (ax[i]*ax[i] + ay[i]*ay[i] + az[i]*az[i]);
+    ++count;
+  }
+  return count > 0 && sum/count >= fMinPower;
+}
+
+
+void QTEventTrigger::DefineCommands()
+{
+  // Define /QT/trigger command directory using generic messenger class
+  fMessenger =
+    new G4GenericMessenger(this, "/QT/trigger/", "Event trigger control");
+
+  auto& activeCmd = fMessenger->DeclareProperty("active", fActive,
+						"Boolean true=apply event trigger before output.");
+  activeCmd.SetParameterName("on", true);
+  activeCmd.SetDefaultValue("false");
+
+  auto& summaryCmd = fMessenger->DeclareProperty("summary", fSummary,
+						 "Boolean true=keep summary rows of rejected events, false=drop.");
+  summaryCmd.SetParameterName("sum", true);
+  summaryCmd.SetDefaultValue("false");
+
+  auto& timeCmd = fMessenger->DeclarePropertyWithUnit("minTrapTime", "ns", fMinTrapTime,
+						      "Minimum trapped time of a trajectory.");
+  timeCmd.SetParameterName("time", true);
+  timeCmd.SetDefaultValue("0 ns");
+
+  auto& powerCmd = fMessenger->DeclareProperty("minPower", fMinPower,
+					       "Minimum mean in-band power, [W] no antenna, [V^2] antenna.");
+  powerCmd.SetParameterName("pw", true);
+  powerCmd.SetRange("pw>=0.");
+  powerCmd.SetDefaultValue("0.0");
+
+  auto& lowCmd = fMessenger->DeclarePropertyWithUnit("bandLow", "MHz", fBandLow,
+						     "Lower cyclotron frequency band limit.");
+  lowCmd.SetParameterName("flow", true);
+  lowCmd.SetDefaultValue("0 MHz");
+
+  auto& highCmd = fMessenger->DeclarePropertyWithUnit("bandHigh", "MHz", fBandHigh,
+						      "Upper cyclotron frequency band limit.");
+  highCmd.SetParameterName("fhigh", true);
+
+  auto& eminCmd = fMessenger->DeclarePropertyWithUnit("eMin", "keV", fEmin,
+						      "Lower vertex kinetic energy window limit.");
+  eminCmd.SetParameterName("emin", true);
+  eminCmd.SetDefaultValue("0 keV");
+
+  auto& emaxCmd = fMessenger->DeclarePropertyWithUnit("eMax", "keV", fEmax,
+						      "Upper vertex kinetic energy window limit.");
+  emaxCmd.SetParameterName("emax", true);
+}
@@ -0,0 +1,207 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTFastTransport
+//
+// Creation date: 2026
+//
+// -------------------------------------------------------------------
+
+#include "QTFastTransport.hh"
+#include "QTBorisScheme.hh"
+#include "QTEquationOfMotion.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Electron.hh"
+#include "G4Track.hh"
+#include "G4Step.hh"
+#include "G4Material.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4UserLimits.hh"
+#include "G4Navigator.hh"
+#include "G4TransportationManager.hh"
+#include "G4PropagatorInField.hh"
+#include "G4FieldManager.hh"
+#include "G4ChordFinder.hh"
+#include "G4VIntegrationDriver.hh"
+#include "G4EquationOfMotion.hh"
+#include "G4ChargeState.hh"
+#include "G4FieldTrack.hh"
+#include "G4Field.hh"
+
+
+QTFastTransport::QTFastTransport(const G4String& name)
+  : G4VProcess(name, fUserDefined),
+    fMinSafety(1.0*mm),
+    fMaxAngle(0.1),
+    fMaxDensity(1.0e-20*g/cm3)
+{
+  pParticleChange = &fParticleChange;
+}
+
+
+QTFastTransport::~QTFastTransport()
+{
+  delete fNavigator;
+}
+
+
+G4bool QTFastTransport::IsApplicable(const G4ParticleDefinition& p)
+{
+  return (&p == G4Electron::Electron());
+}
+
+
+void QTFastTransport::StartTracking(G4Track* track)
+{
+  G4VProcess::StartTracking(track);
+  fHaveSafety = false;
+  fMoved      = false;
+}
+
+
+G4double QTFastTransport::PostStepGetPhysicalInteractionLength(const G4Track& track,
+                                                               G4double,
+                                                               G4ForceCondition* condition)
+{
+  *condition = NotForced;
+  const G4double len = fast_step(track);
+  if (len < DBL_MAX) {
+    fStepLength = len;
+    *condition  = ExclusivelyForced;
+    return len;
+  }
+
+  // back to Geant4 transport: the tracking navigator still points where
+  // the Boris loop took over. The safety ball kept the track inside the
+  // same volume, a relocation within it suffices.
+  if (fMoved) {
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()
+      ->LocateGlobalPointWithinVolume(track.GetPosition());
+    fMoved = false;
+  }
+  return DBL_MAX;
+}
+
+
+G4double QTFastTransport::fast_step(const G4Track& track)
+{
+  // primary electrons in vacuum only
+  if (track.GetParentID() != 0 || track.GetKineticEnergy() <= 0.0) return DBL_MAX;
+  if (track.GetMaterial()->GetDensity() > fMaxDensity) return DBL_MAX;
+
+  // field manager as the propagator finds it: volume, else global
+  auto* tm = G4TransportationManager::GetTransportationManager();
+  G4LogicalVolume* lv = track.GetVolume()->GetLogicalVolume();
+  G4FieldManager*  fm = lv->GetFieldManager();
+  if (!fm) fm = tm->GetFieldManager();
+  const G4Field* field = fm->GetDetectorField();
+  if (!field || !fm->GetChordFinder()) return DBL_MAX;
+
+  // Boris rotation needs a field direction
+  const G4ThreeVector& pos = track.GetPosition();
+  G4double point[4] = { pos.x(), pos.y(), pos.z(), track.GetGlobalTime() };
+  G4double B[6]     = { 0., 0., 0., 0., 0., 0. };
+  field->GetFieldValue(point, B);
+  fBmag = G4ThreeVector(B[0], B[1], B[2]).mag();
+  if (fBmag <= 0.0) return DBL_MAX;
+
+  // step as normal tracking, user limits of the volume stay with Geant4
+  G4double len = tm->GetPropagatorInField()->GetLargestAcceptableStep();
+  if (G4UserLimits* ul = lv->GetUserLimits()) {
+    len = std::min(len, ul->GetMaxAllowedStep(track));
+    if (track.GetKineticEnergy() <= ul->GetUserMinEkine(track)) return DBL_MAX;
+    if (track.GetGlobalTime() + len/track.GetVelocity() >= ul->GetUserMaxTime(track))
+      return DBL_MAX;
+  }
+  if (!is_safe(pos, len)) return DBL_MAX;
+
+  // kernel on the tracking equation of motion, radiation loss needs ours
+  G4EquationOfMotion* eq = fm->GetChordFinder()->GetIntegrationDriver()->GetEquationOfMotion();
+  if (eq != fEquation) {
+    fEquation = eq;
+    fScheme.reset(dynamic_cast<QTEquationOfMotion*>(eq) ? new QTBorisScheme(eq) : nullptr);
+  }
+  if (!fScheme) return DBL_MAX;
+  return len;
+}
+
+
+G4VParticleChange* QTFastTransport::PostStepDoIt(const G4Track& track, const G4Step&)
+{
+  fParticleChange.Initialize(track);
+
+  const G4DynamicParticle* dyn = track.GetDynamicParticle();
+  const G4double mass   = dyn->GetMass();
+  const G4double charge = dyn->GetCharge(); // [eplus]
+  const G4ThreeVector mom = dyn->GetMomentum();
+  const G4double pmag   = mom.mag();
+  fEquation->SetChargeMomentumMass(G4ChargeState(charge, dyn->GetMagneticMoment(),
+                                                 dyn->GetPDGSpin()), pmag, mass);
+
+  // equal pushes of at most fMaxAngle gyration each; the tan(theta/2)
+  // Boris rotation is exact in a uniform field, the angle limit keeps
+  // field gradients and radiation loss resolved
+  const G4double turn = fStepLength*std::fabs(charge)*eplus*c_light*fBmag/pmag; // [rad]
+  const G4int    nPush = std::max(1, (G4int)std::ceil(turn/fMaxAngle));
+  const G4double h     = fStepLength/nPush;
+
+  G4double ya[G4FieldTrack::ncompSVEC] = { 0. };
+  G4double yb[G4FieldTrack::ncompSVEC] = { 0. };
+  const G4ThreeVector& pos = track.GetPosition();
+  ya[0] = pos.x(); ya[1] = pos.y(); ya[2] = pos.z();
+  ya[3] = mom.x(); ya[4] = mom.y(); ya[5] = mom.z();
+  ya[7] = track.GetGlobalTime();
+
+  G4double* yIn  = ya;
+  G4double* yOut = yb;
+  for (G4int i = 0; i < nPush; ++i) {
+    fScheme->DoStep(mass, charge*e_SI, yIn, yOut, h);
+    std::swap(yIn, yOut);
+  }
+
+  const G4ThreeVector pOut(yIn[3], yIn[4], yIn[5]);
+  const G4double etot = std::sqrt(pOut.mag2() + mass*mass);
+  const G4double dt   = yIn[7] - track.GetGlobalTime();
+
+  fParticleChange.ProposePosition(G4ThreeVector(yIn[0], yIn[1], yIn[2]));
+  fParticleChange.ProposeGlobalTime(yIn[7]);
+  fParticleChange.ProposeProperTime(track.GetProperTime() + dt*mass/etot);
+  fParticleChange.ProposeMomentumDirection(pOut.unit());
+  fParticleChange.ProposeEnergy(etot - mass);
+  fParticleChange.ProposeTrueStepLength(fStepLength);
+  // transport, not an interaction: no sensitive detector hits
+  fParticleChange.ProposeSteppingControl(AvoidHitInvocation);
+  fMoved = true;
+  return &fParticleChange;
+}
+
+
+G4bool QTFastTransport::is_safe(const G4ThreeVector& pos, G4double len)
+{
+  // the safety changes by at most the distance moved from its origin
+  const G4double need = len + fMinSafety;
+  const G4double dist = (pos - fSafetyOrigin).mag();
+  if (fHaveSafety) {
+    if (fSafety - dist >= need) return true;
+    if (fSafety + dist <  need) return false;
+  }
+
+  G4Navigator* tracking =
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+  if (!fNavigator) fNavigator = new G4Navigator();
+  if (fNavigator->GetWorldVolume() != tracking->GetWorldVolume())
+    fNavigator->SetWorldVolume(tracking->GetWorldVolume());
+  fNavigator->LocateGlobalPointAndSetup(pos, nullptr, false, true);
+  fSafetyOrigin = pos;
+  fSafety       = fNavigator->ComputeSafety(pos);
+  fHaveSafety   = true;
+  return (fSafety >= need);
+}
@@ -0,0 +1,78 @@
+#include "QTFastTransportPhysics.hh"
+#include "QTFastTransport.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4Electron.hh"
+#include "G4ProcessManager.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+QTFastTransportPhysics::QTFastTransportPhysics(const G4String& name)
+  : G4VPhysicsConstructor(name),
+    fMinSafety(1.0*mm),
+    fMaxAngle(0.1),
+    fMaxDensity(1.0e-20*g/cm3)
+{
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+QTFastTransportPhysics::~QTFastTransportPhysics()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QTFastTransportPhysics::ConstructParticle()
+{
+  G4Electron::Electron();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QTFastTransportPhysics::ConstructProcess()
+{
+  auto* fast = new QTFastTransport();
+  fast->SetMinSafety(fMinSafety);
+  fast->SetMaxAngle(fMaxAngle);
+  fast->SetMaxDensity(fMaxDensity);
+
+  // post step only; last in the DoIt list is the first asked for a step,
+  // an exclusively forced step then skips all other processes
+  G4ProcessManager* pm = G4Electron::Electron()->GetProcessManager();
+  pm->AddDiscreteProcess(fast);
+  pm->SetProcessOrderingToLast(fast, idxPostStep);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QTFastTransportPhysics::DefineCommands()
+{
+  // Define /QT/fastTransport command directory using generic messenger class
+  fMessenger =
+    new G4GenericMessenger(this, "/QT/fastTransport/", "fast vacuum transport control");
+
+  auto& safeCmd = fMessenger->DeclarePropertyWithUnit("minSafety", "mm", fMinSafety,
+					      "Hand e- back to Geant4 closer than this to a boundary, before /run/initialize.");
+  safeCmd.SetParameterName("safety", true);
+  safeCmd.SetDefaultValue("1 mm");
+  safeCmd.SetStates(G4State_PreInit);
+  safeCmd.SetToBeBroadcasted(false);
+
+  auto& angleCmd = fMessenger->DeclareProperty("maxAngle", fMaxAngle,
+					       "Gyration angle per Boris push in [rad], before /run/initialize.");
+  angleCmd.SetParameterName("angle", true);
+  angleCmd.SetDefaultValue("0.1");
+  angleCmd.SetRange("angle>0.");
+  angleCmd.SetStates(G4State_PreInit);
+  angleCmd.SetToBeBroadcasted(false);
+
+  auto& densCmd = fMessenger->DeclarePropertyWithUnit("maxDensity", "g/cm3", fMaxDensity,
+					      "Vacuum: fast transport in materials up to this density, before /run/initialize.");
+  densCmd.SetParameterName("density", true);
+  densCmd.SetDefaultValue("1e-20 g/cm3");
+  densCmd.SetStates(G4State_PreInit);
+  densCmd.SetToBeBroadcasted(false);
+}
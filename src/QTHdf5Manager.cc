@@ -0,0 +1,329 @@
+#include "QTHdf5Manager.hh"
+
+#include "G4AutoLock.hh"
+#include "G4Threading.hh"
+#include "G4StrUtil.hh"
+
+#ifdef HAVE_HDF5
+#include "hdf5.h"
+static_assert(sizeof(hid_t) == sizeof(std::int64_t), "hid_t assumed 64 bit");
+#endif
+
+#include <string>
+
+namespace {
+  // HDF5 library may be built without thread safety; serialise all calls
+  G4Mutex myHdf5Lock = G4MUTEX_INITIALIZER;
+
+#ifdef HAVE_HDF5
+  hid_t createDataset(hid_t loc, const std::string& name, hid_t type,
+		      hsize_t chunk, G4int level)
+  {
+    hsize_t dims[1]    = {0};
+    hsize_t maxdims[1] = {H5S_UNLIMITED};
+    hid_t space = H5Screate_simple(1, dims, maxdims);
+    hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(plist, 1, &chunk);
+    if (level > 0) {
+      H5Pset_shuffle(plist);
+      H5Pset_deflate(plist, (unsigned)level);
+    }
+    hid_t dset = H5Dcreate2(loc, name.c_str(), type, space,
+			    H5P_DEFAULT, plist, H5P_DEFAULT);
+    H5Pclose(plist);
+    H5Sclose(space);
+    return dset;
+  }
+
+  // extend dataset by n elements and write data at the end
+  void appendDataset(hid_t dset, hid_t memtype, const void* data,
+		     hsize_t n, std::int64_t& written)
+  {
+    if (n == 0) return;
+    hsize_t start   = (hsize_t)written;
+    hsize_t newsize = start + n;
+    H5Dset_extent(dset, &newsize);
+    hid_t fspace = H5Dget_space(dset);
+    H5Sselect_hyperslab(fspace, H5S_SELECT_SET, &start, nullptr, &n, nullptr);
+    hid_t mspace = H5Screate_simple(1, &n, nullptr);
+    H5Dwrite(dset, memtype, mspace, fspace, H5P_DEFAULT, data);
+    H5Sclose(mspace);
+    H5Sclose(fspace);
+    written = (std::int64_t)newsize;
+  }
+#endif
+}
+
+
+QTHdf5Manager::~QTHdf5Manager()
+{
+  CloseFile();
+}
+
+
+G4bool QTHdf5Manager::IsHdf5FileName(const G4String& name)
+{
+  return G4StrUtil::ends_with(name, ".h5") || G4StrUtil::ends_with(name, ".hdf5");
+}
+
+
+G4bool QTHdf5Manager::OpenFile(const G4String& name)
+{
+#ifdef HAVE_HDF5
+  // one file per worker, master has no rows to write
+  std::string fname = name;
+  if (G4Threading::IsMultithreadedApplication()) {
+    if (G4Threading::IsMasterThread()) return true;
+    fname.insert(fname.rfind('.'), "_t" + std::to_string(G4Threading::G4GetThreadId()));
+  }
+
+  CloseFile(); // in case of a previous run
+  {
+    G4AutoLock lock(&myHdf5Lock);
+    fFile = H5Fcreate(fname.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  }
+  if (fFile < 0) return false;
+
+  // ntuples booked in a previous run get fresh datasets
+  for (auto& table : fTables) CreateDatasets(table);
+  return true;
+#else
+  G4ExceptionDescription msg;
+  msg << "HDF5 output requested for " << name
+      << " but qtnmSim was built without HDF5.";
+  G4Exception("QTHdf5Manager::OpenFile()", "QTHdf5001", FatalException, msg);
+  return false;
+#endif
+}
+
+
+G4int QTHdf5Manager::CreateNtuple(const G4String& name, const G4String& title)
+{
+  Table table;
+  table.name  = name;
+  table.title = title;
+  fTables.push_back(std::move(table));
+  fFinished = false;
+  return (G4int)fTables.size() - 1; // ids from 0, as G4AnalysisManager
+}
+
+
+G4int QTHdf5Manager::AddColumn(Column&& col)
+{
+  if (fFinished || fTables.empty()) {
+    G4Exception("QTHdf5Manager::AddColumn()", "QTHdf5002", FatalException,
+		"Column created outside CreateNtuple/FinishNtuple.");
+    return -1;
+  }
+  auto& columns = fTables.back().columns;
+  columns.push_back(std::move(col));
+  return (G4int)columns.size() - 1;
+}
+
+
+G4int QTHdf5Manager::CreateNtupleIColumn(const G4String& name)
+{
+  Column col;
+  col.name  = name;
+  col.isInt = true;
+  return AddColumn(std::move(col));
+}
+
+
+G4int QTHdf5Manager::CreateNtupleDColumn(const G4String& name)
+{
+  Column col;
+  col.name = name;
+  return AddColumn(std::move(col));
+}
+
+
+G4int QTHdf5Manager::CreateNtupleIColumn(const G4String& name, std::vector<G4int>& vec)
+{
+  Column col;
+  col.name  = name;
+  col.isInt = true;
+  col.ivec  = &vec;
+  return AddColumn(std::move(col));
+}
+
+
+G4int QTHdf5Manager::CreateNtupleDColumn(const G4String& name, std::vector<G4double>& vec)
+{
+  Column col;
+  col.name = name;
+  col.dvec = &vec;
+  return AddColumn(std::move(col));
+}
+
+
+void QTHdf5Manager::FinishNtuple()
+{
+  fFinished = true;
+  if (fFile >= 0) CreateDatasets(fTables.back());
+}
+
+
+G4bool QTHdf5Manager::FillNtupleIColumn(G4int id, G4int col, G4int val)
+{
+  fTables[id].columns[col].ival = val;
+  return true;
+}
+
+
+G4bool QTHdf5Manager::FillNtupleDColumn(G4int id, G4int col, G4double val)
+{
+  fTables[id].columns[col].dval = val;
+  return true;
+}
+
+
+G4bool QTHdf5Manager::AddNtupleRow(G4int id)
+{
+  Table& table = fTables[id];
+  for (auto& col : table.columns) {
+    if (col.ivec) {
+      col.ibuf.insert(col.ibuf.end(), col.ivec->begin(), col.ivec->end());
+      col.nvalues   += (std::int64_t)col.ivec->size();
+      table.pvalues += col.ivec->size();
+      col.obuf.push_back(col.nvalues);
+    }
+    else if (col.dvec) {
+      col.dbuf.insert(col.dbuf.end(), col.dvec->begin(), col.dvec->end());
+      col.nvalues   += (std::int64_t)col.dvec->size();
+      table.pvalues += col.dvec->size();
+      col.obuf.push_back(col.nvalues);
+    }
+    else if (col.isInt) col.ibuf.push_back(col.ival);
+    else                col.dbuf.push_back(col.dval);
+  }
+  ++table.pending;
+
+  if (table.pending >= fChunkRows || table.pvalues >= fMaxPending) Flush(table);
+  return true;
+}
+
+
+G4bool QTHdf5Manager::Write()
+{
+  for (auto& table : fTables) Flush(table);
+  return true;
+}
+
+
+G4bool QTHdf5Manager::CloseFile()
+{
+  if (fFile < 0) return true;
+  Write();
+#ifdef HAVE_HDF5
+  G4AutoLock lock(&myHdf5Lock);
+  for (auto& table : fTables) {
+    for (auto& col : table.columns) {
+      if (col.dset >= 0) H5Dclose(col.dset);
+      if (col.oset >= 0) H5Dclose(col.oset);
+    }
+    if (table.group >= 0) H5Gclose(table.group);
+  }
+  H5Fclose(fFile);
+#endif
+  for (auto& table : fTables) Reset(table);
+  fFile = -1;
+  return true;
+}
+
+
+void QTHdf5Manager::Clear()
+{
+  for (auto& table : fTables) {
+    for (auto& col : table.columns) {
+      col.ibuf.clear();
+      col.dbuf.clear();
+      col.obuf.clear();
+    }
+    table.pending = 0;
+    table.pvalues = 0;
+  }
+}
+
+
+void QTHdf5Manager::Reset(Table& table)
+{
+  for (auto& col : table.columns) {
+    col.ibuf.clear();
+    col.dbuf.clear();
+    col.obuf.clear();
+    col.nvalues  = 0;
+    col.written  = 0;
+    col.owritten = 0;
+    col.dset     = -1;
+    col.oset     = -1;
+  }
+  table.group   = -1;
+  table.pending = 0;
+  table.pvalues = 0;
+}
+
+
+void QTHdf5Manager::CreateDatasets(Table& table)
+{
+#ifdef HAVE_HDF5
+  G4AutoLock lock(&myHdf5Lock);
+  table.group = H5Gcreate2(fFile, table.name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+  // ntuple title as group attribute
+  hid_t strtype = H5Tcopy(H5T_C_S1);
+  H5Tset_size(strtype, table.title.size() + 1);
+  hid_t aspace = H5Screate(H5S_SCALAR);
+  hid_t attr   = H5Acreate2(table.group, "title", strtype, aspace, H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(attr, strtype, table.title.c_str());
+  H5Aclose(attr);
+  H5Sclose(aspace);
+  H5Tclose(strtype);
+
+  for (auto& col : table.columns) {
+    hid_t ftype = col.isInt ? H5T_STD_I32LE : H5T_IEEE_F64LE;
+    if (col.IsVector()) {
+      col.dset = createDataset(table.group, col.name, ftype, fChunkValues, fCompression);
+      col.oset = createDataset(table.group, col.name + "_offsets", H5T_STD_I64LE,
+			       fChunkRows, fCompression);
+      col.obuf.insert(col.obuf.begin(), 0); // leading offset
+    }
+    else
+      col.dset = createDataset(table.group, col.name, ftype, fChunkRows, fCompression);
+  }
+#endif
+}
+
+
+void QTHdf5Manager::Flush(Table& table)
+{
+  if (fFile < 0 || table.group < 0) { // nothing to write to, e.g. master
+    for (auto& col : table.columns) {
+      col.ibuf.clear();
+      col.dbuf.clear();
+      col.obuf.clear();
+    }
+    table.pending = 0;
+    table.pvalues = 0;
+    return;
+  }
+#ifdef HAVE_HDF5
+  G4AutoLock lock(&myHdf5Lock);
+  for (auto& col : table.columns) {
+    if (col.isInt) {
+      appendDataset(col.dset, H5T_NATIVE_INT, col.ibuf.data(), col.ibuf.size(), col.written);
+      col.ibuf.clear();
+    }
+    else {
+      appendDataset(col.dset, H5T_NATIVE_DOUBLE, col.dbuf.data(), col.dbuf.size(), col.written);
+      col.dbuf.clear();
+    }
+    if (col.IsVector()) {
+      appendDataset(col.oset, H5T_NATIVE_INT64, col.obuf.data(), col.obuf.size(), col.owritten);
+      col.obuf.clear();
+    }
+  }
+#endif
+  table.pending = 0;
+  table.pvalues = 0;
+}
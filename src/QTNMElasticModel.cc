@@ -58,6 +58,7 @@
 #include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
+#include "QTRandom.hh"
 #include "G4ThreeVector.hh"
 
 
@@ -68,8 +69,6 @@ QTNMElasticModel::QTNMElasticModel()
 {
   SetLowEnergyLimit (  0.0*CLHEP::eV);  // ekin = 10 eV   is used if (E< 10  eV)
   SetHighEnergyLimit(100.0*CLHEP::MeV); // ekin = 100 MeV is used if (E>100 MeV)
-
-  fTheDCS = new G4eDPWAElasticDCS(true, false); // init for electron
 }
 
 
@@ -87,20 +86,23 @@ void QTNMElasticModel::Initialise(const G4ParticleDefinition* pdef,
   if(!fParticleChange) {
     fParticleChange = GetParticleChangeForGamma();
   }
-  // init only for the elements that are used in the geometry
-  G4ProductionCutsTable* theCpTable = G4ProductionCutsTable::GetProductionCutsTable();
-  G4int numOfCouples = (G4int)theCpTable->GetTableSize();
-  for(G4int j=0; j<numOfCouples; ++j) {
-    const G4Material* mat = theCpTable->GetMaterialCutsCouple(j)->GetMaterial();
-    const G4ElementVector* elV = mat->GetElementVector();
-    std::size_t numOfElem = mat->GetNumberOfElements();
-    for (std::size_t ie = 0; ie < numOfElem; ++ie) {
-      fTheDCS->InitialiseForZ((*elV)[ie]->GetZasInt());
-    }
-  }
-
-  // will make use of the cross sections so the above needs to be done before
+  // DCS data on master only, workers share it
   if(IsMaster()) {
+    if(!fTheDCS) {
+      fTheDCS = new G4eDPWAElasticDCS(true, false); // init for electron
+    }
+    // init only for the elements that are used in the geometry
+    G4ProductionCutsTable* theCpTable = G4ProductionCutsTable::GetProductionCutsTable();
+    G4int numOfCouples = (G4int)theCpTable->GetTableSize();
+    for(G4int j=0; j<numOfCouples; ++j) {
+      const G4Material* mat = theCpTable->GetMaterialCutsCouple(j)->GetMaterial();
+      const G4ElementVector* elV = mat->GetElementVector();
+      std::size_t numOfElem = mat->GetNumberOfElements();
+      for (std::size_t ie = 0; ie < numOfElem; ++ie) {
+        fTheDCS->InitialiseForZ((*elV)[ie]->GetZasInt());
+      }
+    }
+    // will make use of the cross sections so the above needs to be done before
     InitialiseElementSelectors(pdef, prodcuts);
   }
 }
@@ -110,6 +112,11 @@ void QTNMElasticModel::InitialiseLocal(const G4ParticleDefinition*,
                                                     G4VEmModel* masterModel)
 {
   SetElementSelectors(masterModel->GetElementSelectors());
+  fTheDCS = static_cast<QTNMElasticModel*>(masterModel)->fTheDCS;
+  if (!fTheDCS) {
+    G4Exception("QTNMElasticModel::InitialiseLocal()", "QTNMElastic01", FatalException,
+                "No DCS data on the master model.");
+  }
 }
 
 
@@ -128,6 +135,7 @@ QTNMElasticModel::ComputeCrossSectionPerAtom(const G4ParticleDefinition*,
   // NOTE: cross sections will be zero if the kinetic enrgy is out of the
   //       [10 eV-100 MeV] range for which DCS data has been computed.
   //
+  if (fExcludeHydrogen && (G4int)Z == 1) return 0.0;
   G4double elCS  = 0.0;          // elastic cross section
   G4double tr1CS = 0.0;          // first transport cross section
   G4double tr2CS = 0.0;          // second transport cross section
@@ -150,15 +158,14 @@ QTNMElasticModel::SampleSecondaries(std::vector<G4DynamicParticle*>*,
   const G4Element*  target = SelectTargetAtom(cp, dp->GetParticleDefinition(), ekin, lekin);
   const G4int       izet   = target->GetZasInt();
   // sample cosine of the polar scattering angle in (hard) elastic insteraction
-  CLHEP::HepRandomEngine* rndmEngine = G4Random::getTheEngine();
   G4double cost = 1.0;
   G4double rndm[3];
-  rndmEngine->flatArray(3, rndm);
+  for (auto& r : rndm) r = QTRandom::Flat(QTRandom::kElastic);
   cost = fTheDCS->SampleCosineTheta(izet, lekin, rndm[0], rndm[1], rndm[2]);
 
   // compute the new direction in the scattering frame
   const G4double sint = std::sqrt((1.0-cost)*(1.0+cost));
-  const G4double phi  = CLHEP::twopi*rndmEngine->flat();
+  const G4double phi  = CLHEP::twopi*QTRandom::Flat(QTRandom::kElastic);
   G4ThreeVector theNewDirection(sint*std::cos(phi), sint*std::sin(phi), cost);
   // get original direction in lab frame and rotate new direction to lab frame
   G4ThreeVector theOrgDirectionLab = dp->GetMomentumDirection();
@@ -0,0 +1,144 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTNMIonisationAngles
+//
+// Creation date: 2026
+//
+// -------------------------------------------------------------------
+
+#include "QTNMIonisationAngles.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "G4PhysicalConstants.hh"
+
+namespace {
+  const G4double deg2rad = CLHEP::pi / 180.0;
+
+  // binary encounter density in mu = cos(theta), Lorentzian around G2
+  inline G4double fbeShape(G4double mu, G4double G2, G4double G3)
+  {
+    G4double x = (mu - G2) / G3;
+    return 1.0 / (1.0 + x*x);
+  }
+
+  // backscatter density shape, G5 = 1/3
+  inline G4double fbShape(G4double mu)
+  {
+    G4double x = 3.0*(mu + 1.0);
+    return 1.0 / (1.0 + x*x);
+  }
+
+  inline G4double fbAmplitude(G4double w, G4double t)
+  {
+    const G4double gamma = 10.0;
+    return gamma * std::pow(1 - w/t, 3) / t / (w + 1);
+  }
+
+  // running sum of the per degree weights, first degree empty as the
+  // original angle_pdf; returns the integral [rad]
+  template <class F>
+  G4double buildCdf(const G4double* mu, G4int n, F density, G4double* cdf)
+  {
+    cdf[0] = 0.0;
+    cdf[1] = 0.0;
+    for (G4int i = 1; i < n-1; ++i) cdf[i+1] = cdf[i] + density(mu[i]);
+    const G4double sum = cdf[n-1];
+    for (G4int i = 0; i < n; ++i) cdf[i] /= sum;
+    return sum * deg2rad;
+  }
+}
+
+
+const QTNMIonisationAngles& QTNMIonisationAngles::Instance()
+{
+  static const QTNMIonisationAngles table; // built on first use, thread safe
+  return table;
+}
+
+
+QTNMIonisationAngles::QTNMIonisationAngles()
+: fCdf(nG2*nG3*nAngles)
+, fSum(nG2*nG3)
+, fCdfB(nAngles)
+, fSumB(0.0)
+, fDlnG3((lnG3Max - lnG3Min) / (nG3 - 1))
+{
+  G4double mu[nAngles];
+  for (G4int i = 0; i < nAngles; ++i) mu[i] = std::cos(i * deg2rad);
+
+  for (G4int i2 = 0; i2 < nG2; ++i2) {
+    const G4double G2 = (G4double)i2 / (nG2 - 1);
+    for (G4int i3 = 0; i3 < nG3; ++i3) {
+      const G4double G3 = std::exp(lnG3Min + i3*fDlnG3);
+      const G4int    k  = i2*nG3 + i3;
+      fSum[k] = buildCdf(mu, nAngles, [G2, G3](G4double m) { return fbeShape(m, G2, G3); },
+			 &fCdf[k*nAngles]);
+    }
+  }
+  fSumB = buildCdf(mu, nAngles, fbShape, fCdfB.data());
+}
+
+
+G4double QTNMIonisationAngles::InverseCDF(const G4double* cdf, G4double r) const
+{
+  const G4double* upper = std::lower_bound(cdf + 1, cdf + nAngles, r);
+  if (upper == cdf + nAngles) return nAngles - 1;
+  // constant density within the degree: linear in the CDF
+  const G4double* lower = upper - 1;
+  G4double f = (*upper > *lower) ? (r - *lower) / (*upper - *lower) : 0.0;
+  return (lower - cdf) + f;
+}
+
+
+G4double QTNMIonisationAngles::SampleTheta(G4double w, G4double t,
+					   G4double r1, G4double r2) const
+{
+  // binary encounter parameters, clamped to the physical region
+  G4double G2sq = (w + 1) / t;
+  G2sq          = (G2sq > 0.0) ? std::min(G2sq, 1.0) : 0.0;
+  G4double G2   = std::sqrt(G2sq);
+  G4double G3   = 0.6 * std::sqrt((1 - G2sq) / w);
+
+  // bilinear cell in (G2, ln G3)
+  G4double x2 = G2 * (nG2 - 1);
+  G4double x3 = (G3 > 0.0) ? (std::log(G3) - lnG3Min) / fDlnG3 : 0.0;
+  x3          = std::min(std::max(x3, 0.0), (G4double)(nG3 - 1));
+  G4int    i2 = std::min((G4int)x2, nG2 - 2);
+  G4int    i3 = std::min((G4int)x3, nG3 - 2);
+  G4double a2 = x2 - i2;
+  G4double a3 = x3 - i3;
+  G4double c00 = (1 - a2) * (1 - a3), c01 = (1 - a2) * a3;
+  G4double c10 = a2 * (1 - a3),       c11 = a2 * a3;
+  G4int    k   = i2*nG3 + i3;
+
+  // mixture: backscatter part with probability of its integral
+  G4double sumBE = c00*fSum[k] + c01*fSum[k+1] + c10*fSum[k+nG3] + c11*fSum[k+nG3+1];
+  G4double sumB  = std::max(fbAmplitude(w, t), 0.0) * fSumB;
+  if (r1 * (sumBE + sumB) < sumB)
+    return InverseCDF(fCdfB.data(), r2) * deg2rad;
+
+  G4double deg = c00 * InverseCDF(&fCdf[k*nAngles], r2)
+               + c01 * InverseCDF(&fCdf[(k+1)*nAngles], r2)
+               + c10 * InverseCDF(&fCdf[(k+nG3)*nAngles], r2)
+               + c11 * InverseCDF(&fCdf[(k+nG3+1)*nAngles], r2);
+  return deg * deg2rad;
+}
+
+
+G4double
+QTNMIonisationAngles::fbe(G4double w, G4double t, G4double theta)
+{
+  G4double G2 = std::sqrt((w+1)/t);
+  G4double G3 = 0.6 * std::sqrt((1 - pow(G2,2)) / w);
+  return fbeShape(std::cos(theta), G2, G3);
+}
+
+G4double
+QTNMIonisationAngles::fb(G4double w, G4double t, G4double theta)
+{
+  return fbAmplitude(w, t) * fbShape(std::cos(theta));
+}
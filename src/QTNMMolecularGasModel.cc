@@ -0,0 +1,398 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTNMMolecularGasModel
+//
+// Creation date: 2026
+//
+// -------------------------------------------------------------------
+
+#include "QTNMMolecularGasModel.hh"
+#include "QTNMIonisationAngles.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "G4ParticleChangeForGamma.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4DataVector.hh"
+#include "G4Electron.hh"
+
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "QTRandom.hh"
+#include "G4ThreeVector.hh"
+
+namespace {
+  // atomic units
+  const G4double R_ev    = 13.6057;    // Rydberg [eV]
+  const G4double a02_cm2 = 2.80028e-17; // Bohr radius squared [cm^2]
+  const G4double mc2_ev  = 510998.95;  // electron mass [eV]
+
+  // H2 orbital for BEB, https://doi.org/10.1103/PhysRevA.50.3954
+  const G4double B_ev = 15.43;  // binding energy [eV]
+  const G4double U_ev = 15.98;  // orbital kinetic energy [eV]
+  const G4int    N_el = 2;      // occupation
+
+  // total inelastic Bethe parameters, Liu, https://doi.org/10.1103/PhysRevA.7.103
+  const G4double M2_tot = 1.5487;
+  // excitation: dipole strength left after the BEB asymptote N R / (2B),
+  // C_exc such that excitation plus ionisation give Liu's total inelastic
+  // cross section 4 pi a0^2 R/T M2_tot ln(4 C_tot T/R), C_tot = 1.2213, at 18.6 keV
+  const G4double M2_exc = M2_tot - N_el * R_ev / (2.0 * B_ev);
+  const G4double C_exc  = 3.4676;
+  const G4double E_exc  = 11.18; // lowest dipole allowed excitation, B state [eV]
+
+  // squared momentum [1/a0^2] for kinetic energy [eV]
+  inline G4double momentum2(G4double T_ev)
+  {
+    return T_ev * (1.0 + 0.5 * T_ev / mc2_ev) / R_ev;
+  }
+
+  // energy loss spectrum of 18.6 keV electrons in T2 per inelastic
+  // collision, Aseev et al., https://doi.org/10.1007/s100530050124
+  inline G4double aseevLoss(G4double e)
+  {
+    const G4double A1 = 0.204,  w1 = 1.85, e1 = 12.6;
+    const G4double A2 = 0.0556, w2 = 12.5, e2 = 14.30;
+    const G4double ec = 14.09;
+    if (e < ec) return A1 * std::exp(-2.0 * (e - e1)*(e - e1) / (w1*w1));
+    return A2 * w2*w2 / (w2*w2 + 4.0 * (e - e2)*(e - e2));
+  }
+
+  // BEB secondary energy CDF, unnormalised, w = W/B, t = T/B
+  inline G4double bebCdf(G4double w, G4double t)
+  {
+    const G4double lt = std::log(t);
+    return -(std::log(w + 1) - std::log(t - w) + lt) / (t + 1)
+      + (1 - 1/(w + 1)) + (1/(t - w) - 1/t)
+      + 0.5 * lt * (1 - 1/((w + 1)*(w + 1)) + 1/((t - w)*(t - w)) - 1/(t*t));
+  }
+
+  // fractional index where the increasing cdf[0..n) reaches r, linear
+  // between nodes
+  inline G4double inverseCdf(const G4double* cdf, G4int n, G4double r)
+  {
+    const G4double* upper = std::lower_bound(cdf + 1, cdf + n, r);
+    if (upper == cdf + n) return n - 1;
+    const G4double* lower = upper - 1;
+    G4double f = (*upper > *lower) ? (r - *lower) / (*upper - *lower) : 0.0;
+    return (lower - cdf) + f;
+  }
+
+  // linear interpolation at fractional index x
+  inline G4double lookup(const std::vector<G4double>& v, G4double x)
+  {
+    const G4int n = (G4int)v.size();
+    x = std::min(std::max(x, 0.0), (G4double)(n - 1));
+    G4int    i = std::min((G4int)x, n - 2);
+    G4double a = x - i;
+    return (1.0 - a) * v[i] + a * v[i+1];
+  }
+}
+
+
+QTNMMolecularGasModel::QTNMMolecularGasModel()
+: G4VEmModel("eMolecularGasScattering"),
+  fParticleChange(nullptr)
+{
+  SetLowEnergyLimit (  0.0*CLHEP::eV);  // ekin = 10 eV   is used if (E< 10  eV)
+  SetHighEnergyLimit(100.0*CLHEP::MeV); // ekin = 100 MeV is used if (E>100 MeV)
+}
+
+
+QTNMMolecularGasModel::~QTNMMolecularGasModel()
+{
+}
+
+
+void QTNMMolecularGasModel::Initialise(const G4ParticleDefinition* pdef,
+                                       const G4DataVector& prodcuts)
+{
+  if(!fParticleChange) {
+    fParticleChange = GetParticleChangeForGamma();
+  }
+  // tables do not depend on the geometry, one set for all threads
+  fTables = &shared_tables(HighEnergyLimit() / CLHEP::eV);
+  if(IsMaster()) {
+    // angular sampling table, shared by all threads
+    QTNMIonisationAngles::Instance();
+    // will make use of the cross sections so the above needs to be done before
+    InitialiseElementSelectors(pdef, prodcuts);
+  }
+}
+
+
+void QTNMMolecularGasModel::InitialiseLocal(const G4ParticleDefinition*,
+                                            G4VEmModel* masterModel)
+{
+  SetElementSelectors(masterModel->GetElementSelectors());
+}
+
+
+const QTNMMolecularGasModel::Tables& QTNMMolecularGasModel::shared_tables(G4double Tmax)
+{
+  static const Tables tables = [Tmax] { Tables t; build_tables(t, Tmax); return t; }();
+  return tables;
+}
+
+
+// Per hydrogen atom, i.e. half the molecular cross section
+G4double
+QTNMMolecularGasModel::ComputeCrossSectionPerAtom(const G4ParticleDefinition*,
+                                                  G4double ekin,
+                                                  G4double Z,
+                                                  G4double /*A*/,
+                                                  G4double /*prodcut*/,
+                                                  G4double /*emax*/)
+{
+  if ((G4int)Z != 1) return 0.0;
+  const G4double T_ev = ekin / CLHEP::eV;
+
+  G4double sigma = 0.0;
+  if (fTables) {
+    const Tables& tab = *fTables;
+    G4double x = (std::log(T_ev) - tab.logTmin) / tab.dlogT;
+    sigma = lookup(tab.elastic, x);
+    if (T_ev > E_exc) sigma += lookup(tab.excitation, x);
+    if (T_ev > B_ev)  sigma += lookup(tab.ionisation, x);
+  }
+  else { // before Initialise, e.g. from G4EmCalculator
+    sigma = ElasticCrossSection(T_ev) + ExcitationCrossSection(T_ev)
+      + IonisationCrossSection(T_ev);
+  }
+  return 0.5 * sigma * CLHEP::cm * CLHEP::cm;
+}
+
+
+void
+QTNMMolecularGasModel::SampleSecondaries(std::vector<G4DynamicParticle*>* fvect,
+                                         const G4MaterialCutsCouple*,
+                                         const G4DynamicParticle* dp,
+                                         G4double, G4double)
+{
+  const G4double T_ev = dp->GetKineticEnergy() / CLHEP::eV;
+  const Tables&  tab  = *fTables;
+
+  // channel
+  G4double x    = (std::log(T_ev) - tab.logTmin) / tab.dlogT;
+  G4double sEl  = lookup(tab.elastic, x);
+  G4double sExc = (T_ev > E_exc) ? lookup(tab.excitation, x) : 0.0;
+  G4double sIon = (T_ev > B_ev)  ? lookup(tab.ionisation, x) : 0.0;
+  G4double r    = QTRandom::Flat(QTRandom::kIonisation) * (sEl + sExc + sIon);
+
+  // Original direction of particle in lab frame
+  G4ThreeVector dir_lab = dp->GetMomentumDirection();
+
+  if (r < sEl) { // elastic, recoil energy neglected
+    G4double cost = sample_elastic_cost(T_ev, QTRandom::Flat(QTRandom::kElastic));
+    G4double sint = std::sqrt((1.0-cost)*(1.0+cost));
+    G4double phi  = CLHEP::twopi*QTRandom::Flat(QTRandom::kElastic);
+    G4ThreeVector theNewDirection(sint*std::cos(phi), sint*std::sin(phi), cost);
+    theNewDirection.rotateUz(dir_lab);
+    fParticleChange->ProposeMomentumDirection(theNewDirection);
+    return;
+  }
+
+  if (r < sEl + sExc) { // excitation, de-excitation deposited locally
+    G4double loss = sample_excitation_loss(T_ev, QTRandom::Flat(QTRandom::kIonisation));
+    G4double cost = sample_inelastic_cost(T_ev, loss, QTRandom::Flat(QTRandom::kIonisation));
+    G4double sint = std::sqrt((1.0-cost)*(1.0+cost));
+    G4double phi  = CLHEP::twopi*QTRandom::Flat(QTRandom::kIonisation);
+    G4ThreeVector theNewDirection(sint*std::cos(phi), sint*std::sin(phi), cost);
+    theNewDirection.rotateUz(dir_lab);
+    fParticleChange->ProposeMomentumDirection(theNewDirection);
+    fParticleChange->SetProposedKineticEnergy((T_ev - loss) * CLHEP::eV);
+    fParticleChange->ProposeLocalEnergyDeposit(loss * CLHEP::eV);
+    return;
+  }
+
+  // ionisation
+  G4double enew     = sample_secondary_energy(T_ev, QTRandom::Flat(QTRandom::kIonisation));
+  G4double prim_new = T_ev - enew - B_ev;
+  G4double w = prim_new / B_ev;
+  G4double t = T_ev / B_ev;
+  const QTNMIonisationAngles& angles = QTNMIonisationAngles::Instance();
+
+  // Deflection of primary particle
+  G4double cost = std::cos(angles.SampleTheta(w, t, QTRandom::Flat(QTRandom::kIonisation),
+					      QTRandom::Flat(QTRandom::kIonisation)));
+  G4double sint = std::sqrt((1.0-cost)*(1.0+cost));
+  G4double phi  = CLHEP::twopi*QTRandom::Flat(QTRandom::kIonisation);
+  G4ThreeVector theNewDirection(sint*std::cos(phi), sint*std::sin(phi), cost);
+  theNewDirection.rotateUz(dir_lab);
+  fParticleChange->ProposeMomentumDirection(theNewDirection);
+  fParticleChange->SetProposedKineticEnergy(prim_new * CLHEP::eV);
+  fParticleChange->ProposeLocalEnergyDeposit(B_ev * CLHEP::eV);
+
+  // Add secondary particle
+  w    = enew / B_ev;
+  cost = std::cos(angles.SampleTheta(w, t, QTRandom::Flat(QTRandom::kIonisation),
+				     QTRandom::Flat(QTRandom::kIonisation)));
+  sint = std::sqrt((1.0-cost)*(1.0+cost));
+  phi  = CLHEP::twopi*QTRandom::Flat(QTRandom::kIonisation);
+  theNewDirection.set(sint*std::cos(phi), sint*std::sin(phi), cost);
+  theNewDirection.rotateUz(dir_lab);
+  auto newp = new G4DynamicParticle (G4Electron::Electron(), theNewDirection, enew * CLHEP::eV);
+  fvect->push_back(newp);
+}
+
+
+// Elastic: measured values [1e-16 cm^2] below 400 eV, as used in KATRIN's
+// Kassiopeia, first Born approximation of Liu above,
+// https://doi.org/10.1103/PhysRevA.35.591
+G4double QTNMMolecularGasModel::ElasticCrossSection(G4double T_ev)
+{
+  static const G4double e[14] = {0., 1.5, 5., 7., 10., 15., 20., 30., 60., 100., 150., 200., 300., 400.};
+  static const G4double s[14] = {9.6, 13., 15., 12., 10., 7., 5.6, 3.3, 1.1, 0.9, 0.5, 0.36, 0.23, 0.15};
+  if (T_ev >= 400.0) {
+    const G4double emass = mc2_ev / (2.0 * R_ev); // [Hartree]
+    const G4double T     = T_ev / (2.0 * R_ev);
+    const G4double gam   = (emass + T) / emass;
+    return gam*gam * CLHEP::pi / (2.0*T) * (4.2106 - 2.0/T) * a02_cm2;
+  }
+  G4int i = (G4int)(std::upper_bound(e, e + 14, std::max(T_ev, 0.0)) - e) - 1;
+  i       = std::min(i, 12);
+  return (s[i] + (T_ev - e[i]) * (s[i+1] - s[i]) / (e[i+1] - e[i])) * 1e-16;
+}
+
+
+// Excitation: Bethe form with the dipole strength not taken by ionisation,
+// vanishing at the lowest excitation threshold
+G4double QTNMMolecularGasModel::ExcitationCrossSection(G4double T_ev)
+{
+  if (T_ev <= E_exc) return 0.0;
+  G4double sigma = 4.0*CLHEP::pi*a02_cm2 * R_ev/T_ev * M2_exc * std::log(C_exc * T_ev / R_ev)
+    * (1.0 - E_exc / T_ev);
+  return std::max(sigma, 0.0);
+}
+
+
+// Ionisation: BEB for the H2 orbital
+G4double QTNMMolecularGasModel::IonisationCrossSection(G4double T_ev)
+{
+  const G4double t = T_ev / B_ev;
+  if (t <= 1.0) return 0.0;
+  const G4double u  = U_ev / B_ev;
+  const G4double S  = 4.0*CLHEP::pi*a02_cm2 * N_el * (R_ev/B_ev)*(R_ev/B_ev);
+  const G4double lt = std::log(t);
+  return S / (t + u + 1) * (0.5*lt*(1 - 1/(t*t)) + 1 - 1/t - lt/(t + 1));
+}
+
+
+void QTNMMolecularGasModel::build_tables(Tables& tab, G4double Tmax)
+{
+  // channel cross sections from 1 eV to the model high energy limit
+  tab.logTmin = 0.0;
+  tab.dlogT   = std::log(10.0) / nTPerDecade;
+  tab.nT      = std::max(2, (G4int)std::ceil(std::log(Tmax) / tab.dlogT) + 1);
+  tab.elastic.resize(tab.nT);
+  tab.excitation.resize(tab.nT);
+  tab.ionisation.resize(tab.nT);
+  for (G4int k = 0; k < tab.nT; ++k) {
+    G4double T_ev = std::exp(tab.logTmin + k*tab.dlogT);
+    tab.elastic[k]    = ElasticCrossSection(T_ev);
+    tab.excitation[k] = ExcitationCrossSection(T_ev);
+    tab.ionisation[k] = IonisationCrossSection(T_ev);
+  }
+
+  // excitation energy loss below the ionisation threshold, trapezoidal
+  // CDF normalised to one at B
+  const G4int nLoss = (G4int)std::lround((B_ev - excLossMin) / excLossStep) + 1;
+  tab.excCdf.assign(nLoss, 0.0);
+  for (G4int i = 1; i < nLoss; ++i) {
+    G4double e = excLossMin + i*excLossStep;
+    tab.excCdf[i] = tab.excCdf[i-1] + 0.5*excLossStep * (aseevLoss(e - excLossStep) + aseevLoss(e));
+  }
+  for (auto& c : tab.excCdf) c /= tab.excCdf[nLoss-1];
+
+  // secondary energy CDFs on a log(T - B) grid, fine close to threshold,
+  // exact BEB integral at the W nodes
+  const G4double umin = 1e-3 * B_ev;
+  tab.logUmin = std::log(umin);
+  tab.dlogU   = std::log(10.0) / nTPerDecade;
+  tab.nU      = std::max(2, (G4int)std::ceil(std::log((Tmax - B_ev)/umin) / tab.dlogU) + 1);
+  tab.ionCdf.resize(tab.nU * nW);
+  for (G4int k = 0; k < tab.nU; ++k) {
+    const G4double t    = (B_ev + std::exp(tab.logUmin + k*tab.dlogU)) / B_ev;
+    const G4double lmax = std::log(1.0 + 0.5*(t - 1));
+    const G4double norm = bebCdf(0.5*(t - 1), t);
+    G4double* cdf = &tab.ionCdf[k*nW];
+    for (G4int j = 0; j < nW; ++j) {
+      G4double w = std::expm1(j * lmax / (nW - 1));
+      cdf[j] = bebCdf(w, t) / norm;
+    }
+    cdf[0]    = 0.0;
+    cdf[nW-1] = 1.0;
+  }
+}
+
+
+G4double
+QTNMMolecularGasModel::sample_excitation_loss(G4double T_ev, G4double rndm) const
+{
+  // losses above T are not accessible
+  const std::vector<G4double>& cdf = fTables->excCdf;
+  const G4int n    = (G4int)cdf.size();
+  G4double    xmax = std::min((T_ev - excLossMin) / excLossStep, (G4double)(n - 1));
+  if (xmax <= 0.0) return std::min(T_ev, excLossMin);
+  G4double pos = inverseCdf(cdf.data(), n, rndm * lookup(cdf, xmax));
+  return excLossMin + pos*excLossStep;
+}
+
+
+G4double
+QTNMMolecularGasModel::sample_secondary_energy(G4double T_ev, G4double rndm) const
+{
+  // Inverse CDF at the two neighbouring nodes with the same random
+  // number, position on the W grid interpolated in log(T - B)
+  const Tables& tab = *fTables;
+  G4double x  = (std::log(T_ev - B_ev) - tab.logUmin) / tab.dlogU;
+  x           = std::min(std::max(x, 0.0), (G4double)(tab.nU - 1));
+  G4int    iU = std::min((G4int)x, tab.nU - 2);
+  G4double aU = x - iU;
+  G4double pos = (1.0 - aU) * inverseCdf(&tab.ionCdf[iU*nW], nW, rndm)
+               + aU * inverseCdf(&tab.ionCdf[(iU+1)*nW], nW, rndm);
+
+  const G4double lmax = std::log(1.0 + 0.5*(T_ev - B_ev)/B_ev);
+  return B_ev * std::expm1(pos * lmax / (nW - 1));
+}
+
+
+// First Born elastic scattering on the H atom,
+// dsigma/dK^2 ~ (8 + K^2)^2 / (4 + K^2)^4 with K the momentum transfer [1/a0];
+// uniform in v = (1 + 4/(4 + K^2))^3, inverted analytically
+G4double
+QTNMMolecularGasModel::sample_elastic_cost(G4double T_ev, G4double rndm) const
+{
+  const G4double k2   = momentum2(T_ev);
+  const G4double vmin = std::pow(1.0 + 1.0/(1.0 + k2), 3);
+  const G4double v    = vmin + rndm * (8.0 - vmin);
+  const G4double s    = 0.25 * (std::cbrt(v) - 1.0);
+  const G4double K2   = (s > 0.0) ? 1.0/s - 4.0 : 4.0*k2;
+  return std::max(-1.0, 1.0 - 0.5*K2/k2);
+}
+
+
+// Inelastic deflection: dsigma/dK^2 ~ 1/(K^2 (1 + K^2)), dipole like at
+// small and free electron like at large momentum transfer K [1/a0],
+// uniform in ln(K^2/(1 + K^2)) between the kinematic limits
+G4double
+QTNMMolecularGasModel::sample_inelastic_cost(G4double T_ev, G4double loss,
+                                             G4double rndm) const
+{
+  const G4double k2  = momentum2(T_ev);
+  const G4double kp2 = momentum2(std::max(T_ev - loss, 0.0));
+  const G4double kkp = std::sqrt(k2 * kp2);
+  if (kkp <= 0.0) return 1.0;
+  // (k - k')^2 without cancellation
+  const G4double dk    = (k2 - kp2) / (std::sqrt(k2) + std::sqrt(kp2));
+  const G4double K2min = std::max(dk*dk, 1e-300);
+  const G4double K2max = k2 + kp2 + 2.0*kkp;
+  const G4double lmin  = std::log(K2min / (1.0 + K2min));
+  const G4double lmax  = std::log(K2max / (1.0 + K2max));
+  const G4double q     = std::exp(lmin + rndm * (lmax - lmin));
+  const G4double K2    = q / (1.0 - q);
+  return std::min(1.0, std::max(-1.0, (k2 + kp2 - K2) / (2.0*kkp)));
+}
@@ -0,0 +1,47 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTNMMultiModel
+//
+// Creation date: 2026
+//
+// -------------------------------------------------------------------
+
+#include "QTNMMultiModel.hh"
+
+
+QTNMMultiModel::QTNMMultiModel(const G4String& name)
+  : G4EmMultiModel(name)
+{}
+
+
+void QTNMMultiModel::AddModel(G4VEmModel* model)
+{
+  G4EmMultiModel::AddModel(model);
+  if (model) fModels.push_back(model);
+}
+
+
+void QTNMMultiModel::Initialise(const G4ParticleDefinition* part,
+                                const G4DataVector& cuts)
+{
+  // set by the process for this model only
+  for (G4VEmModel* model : fModels) model->SetMasterThread(IsMaster());
+  G4EmMultiModel::Initialise(part, cuts);
+}
+
+
+void QTNMMultiModel::InitialiseLocal(const G4ParticleDefinition* part,
+                                     G4VEmModel* masterModel)
+{
+  auto* master = static_cast<QTNMMultiModel*>(masterModel);
+  if (master->fModels.size() != fModels.size()) {
+    G4Exception("QTNMMultiModel::InitialiseLocal()", "QTNMMulti01", FatalException,
+                "Worker and master multi-models differ in their sub-models.");
+    return;
+  }
+  for (std::size_t i = 0; i < fModels.size(); ++i) {
+    fModels[i]->InitialiseLocal(part, master->fModels[i]);
+  }
+}
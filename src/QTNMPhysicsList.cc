@@ -18,12 +18,14 @@
 #include "G4LivermorePhotoElectricModel.hh"
 
 // e+-
-#include "G4EmMultiModel.hh"
+#include "QTNMMultiModel.hh"
 #include "G4eDPWACoulombScatteringModel.hh"
 #include "QTNMElasticModel.hh"
 #include "QTNMeImpactIonisation.hh"
+#include "QTNMMolecularGasModel.hh"
 #include "G4eSingleCoulombScatteringModel.hh"
 #include "G4CoulombScattering.hh"
+#include "QTWoodcockScattering.hh"
 #include "G4eIonisation.hh"
 #include "G4eBremsstrahlung.hh"
 #include "G4Generator2BS.hh"
@@ -83,11 +85,15 @@ QTNMPhysicsList::QTNMPhysicsList(G4int ver,
   param->SetUseICRU90Data(true);
   param->SetMaxNIELEnergy(1*CLHEP::MeV);
   SetPhysicsType(bElectromagnetic);
+  DefineCommands();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-QTNMPhysicsList::~QTNMPhysicsList() = default;
+QTNMPhysicsList::~QTNMPhysicsList()
+{
+  delete fMessenger;
+}
 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -156,19 +162,10 @@ void QTNMPhysicsList::ConstructProcess()
   // e-
   particle = G4Electron::Electron();
 
-  // Coulomb Scattering
-  G4CoulombScattering* ss = new G4CoulombScattering();
+  // Coulomb Scattering, optionally with Woodcock tracking
+  G4CoulombScattering* ss = fWoodcock ? new QTWoodcockScattering() : new G4CoulombScattering();
   ss->SetEmModel(new G4eSingleCoulombScatteringModel()); // high energy
-  G4EmMultiModel* mm = new G4EmMultiModel("CoulombSSModels");
-  // Elastic Scattering
-  mm->AddModel(new QTNMElasticModel());
-  // Impact Ionisation
-  mm->AddModel(new QTNMeImpactIonisation());
-  // add common limits to multimodel
-  mm->SetLowEnergyLimit (  0.0*CLHEP::eV);  // ekin = 10 eV is used if (E< 10 eV)
-  mm->SetHighEnergyLimit(100.0*CLHEP::MeV); // high energy model for ekin > 100 MeV
-
-  ss->AddEmModel(0, mm);
+  ss->AddEmModel(0, BuildElectronScatteringModels(fMolecularGas));
 
   // bremsstrahlung
   G4eBremsstrahlung* brem = new G4eBremsstrahlung();
@@ -220,3 +217,63 @@ void QTNMPhysicsList::ConstructProcess()
   G4EmBuilder::ConstructCharged(hmsc, pnuc);
 
 }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+QTNMMultiModel* QTNMPhysicsList::BuildElectronScatteringModels(G4bool molecularGas)
+{
+  QTNMMultiModel* mm = new QTNMMultiModel("CoulombSSModels");
+  if (molecularGas) {
+    // hydrogen isotope molecules: elastic, excitation, ionisation
+    mm->AddModel(new QTNMMolecularGasModel());
+    // atomic models for all other elements
+    auto* elastic = new QTNMElasticModel();
+    elastic->SetExcludeHydrogen(true);
+    mm->AddModel(elastic);
+    auto* ionisation = new QTNMeImpactIonisation();
+    ionisation->SetExcludeHydrogen(true);
+    mm->AddModel(ionisation);
+  }
+  else {
+    // Elastic Scattering
+    mm->AddModel(new QTNMElasticModel());
+    // Impact Ionisation
+    mm->AddModel(new QTNMeImpactIonisation());
+  }
+  // add common limits to multimodel
+  mm->SetLowEnergyLimit (  0.0*CLHEP::eV);  // ekin = 10 eV is used if (E< 10 eV)
+  mm->SetHighEnergyLimit(100.0*CLHEP::MeV); // high energy model for ekin > 100 MeV
+  return mm;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QTNMPhysicsList::DefineCommands()
+{
+  fMessenger = DefineElectronCommands(this, fMolecularGas, fWoodcock);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4GenericMessenger* QTNMPhysicsList::DefineElectronCommands(void* owner, G4bool& molecularGas,
+                                                            G4bool& woodcock)
+{
+  // Define /QT/physics command directory using generic messenger class
+  auto* messenger =
+    new G4GenericMessenger(owner, "/QT/physics/", "physics control");
+
+  auto& molCmd = messenger->DeclareProperty("molecularGas", molecularGas,
+					     "Scatter e- on hydrogen isotopes as H2/D2/T2 molecules, before /run/initialize.");
+  molCmd.SetParameterName("molecular", true);
+  molCmd.SetDefaultValue("true");
+  molCmd.SetStates(G4State_PreInit);
+  molCmd.SetToBeBroadcasted(false);
+
+  auto& wcCmd = messenger->DeclareProperty("woodcock", woodcock,
+					    "Sample e- Coulomb scattering against a majorant (null collisions), before /run/initialize.");
+  wcCmd.SetParameterName("woodcock", true);
+  wcCmd.SetDefaultValue("true");
+  wcCmd.SetStates(G4State_PreInit);
+  wcCmd.SetToBeBroadcasted(false);
+  return messenger;
+}
@@ -0,0 +1,85 @@
+#include "QTNMTrapPhysics.hh"
+#include "QTNMPhysicsList.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4EmParameters.hh"
+#include "G4EmBuilder.hh"
+
+#include "QTNMMultiModel.hh"
+#include "G4CoulombScattering.hh"
+#include "QTWoodcockScattering.hh"
+
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+
+#include "G4PhysicsListHelper.hh"
+#include "G4BuilderType.hh"
+
+// factory
+#include "G4PhysicsConstructorFactory.hh"
+//
+G4_DECLARE_PHYSCONSTR_FACTORY(QTNMTrapPhysics);
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+QTNMTrapPhysics::QTNMTrapPhysics(G4int ver,
+                                 const G4String&)
+  : G4VPhysicsConstructor("QTNMTrapPhysics"), verbose(ver)
+{
+  G4EmParameters* param = G4EmParameters::Instance();
+  param->SetDefaults();
+  param->SetVerbose(verbose);
+  param->SetMinEnergy(100*CLHEP::eV);
+  param->SetMaxEnergy(1*CLHEP::MeV);  // trap electrons, short tables
+  param->SetLowestElectronEnergy(100*CLHEP::eV);
+  param->SetNumberOfBinsPerDecade(20);
+  param->SetMscThetaLimit(0.0);
+  param->SetGeneralProcessActive(false);
+  SetPhysicsType(bElectromagnetic);
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+QTNMTrapPhysics::~QTNMTrapPhysics()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QTNMTrapPhysics::ConstructParticle()
+{
+  // e- transport only, gamma and e+ for generator settings
+  G4Electron::Electron();
+  G4Positron::Positron();
+  G4Gamma::Gamma();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QTNMTrapPhysics::ConstructProcess()
+{
+  if(verbose > 1) {
+    G4cout << "### " << GetPhysicsName() << " Construct Processes " << G4endl;
+  }
+  G4EmBuilder::PrepareEMPhysics();
+
+  G4PhysicsListHelper* ph = G4PhysicsListHelper::GetPhysicsListHelper();
+
+  // e- Coulomb scattering, elastic and impact ionisation, optionally
+  // with Woodcock tracking
+  G4CoulombScattering* ss = fWoodcock ? new QTWoodcockScattering() : new G4CoulombScattering();
+  ss->SetEmModel(QTNMPhysicsList::BuildElectronScatteringModels(fMolecularGas));
+  ph->RegisterProcess(ss, G4Electron::Electron());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void QTNMTrapPhysics::DefineCommands()
+{
+  // same /QT/physics/ commands as QTNMPhysicsList
+  fMessenger = QTNMPhysicsList::DefineElectronCommands(this, fMolecularGas, fWoodcock);
+}
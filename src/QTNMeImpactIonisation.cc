@@ -36,10 +36,10 @@
 // -------------------------------------------------------------------
 
 #include "QTNMeImpactIonisation.hh"
+#include "QTNMIonisationAngles.hh"
+#include "QTNMBindingEnergies.hh"
 
-#include <fstream>
 #include <sstream>
-#include <iterator>
 #include <algorithm>
 
 #include "G4ParticleChangeForGamma.hh"
@@ -56,20 +56,19 @@
 #include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
+#include "QTRandom.hh"
 #include "G4ThreeVector.hh"
 
 
+G4bool QTNMeImpactIonisation::validate_tables = false;
+
+
 QTNMeImpactIonisation::QTNMeImpactIonisation()
 : G4VEmModel("eImpactIonisation"),
   fParticleChange(nullptr)
 {
   SetLowEnergyLimit (  0.0*CLHEP::eV);  // ekin = 10 eV   is used if (E< 10  eV)
   SetHighEnergyLimit(100.0*CLHEP::MeV); // ekin = 100 MeV is used if (E>100 MeV)
-  secondary_energy.reserve(nESpace);
-  // Angular sampling points for secondary scatter
-  const G4double a = CLHEP::pi / 180.0;
-  std::generate(angle.begin(), angle.end(), [n = 0, &a]() mutable { return n++ * a; });
-  generator.seed(rd()); // using random seed
 }
 
 
@@ -84,21 +83,46 @@ void QTNMeImpactIonisation::Initialise(const G4ParticleDefinition* pdef,
   if(!fParticleChange) {
     fParticleChange = GetParticleChangeForGamma();
   }
-  // init only for the elements that are used in the geometry
-  G4ProductionCutsTable* theCpTable = G4ProductionCutsTable::GetProductionCutsTable();
-  G4int numOfCouples = (G4int)theCpTable->GetTableSize();
-  for(G4int j=0; j<numOfCouples; ++j) {
-    const G4Material* mat = theCpTable->GetMaterialCutsCouple(j)->GetMaterial();
-    const G4ElementVector* elV = mat->GetElementVector();
-    std::size_t numOfElem = mat->GetNumberOfElements();
-    for (std::size_t ie = 0; ie < numOfElem; ++ie) {
-      G4int Z = (*elV)[ie]->GetZasInt();
-      // Load the ionisation energies
-      load_ionisation_energies(Z);
-    }
-  }
-  // will make use of the cross sections so the above needs to be done before
+  // per element tables on master only, workers share them
   if(IsMaster()) {
+    // elements used in the geometry without tables
+    std::vector<G4int> missing;
+    G4ProductionCutsTable* theCpTable = G4ProductionCutsTable::GetProductionCutsTable();
+    G4int numOfCouples = (G4int)theCpTable->GetTableSize();
+    for(G4int j=0; j<numOfCouples; ++j) {
+      const G4Material* mat = theCpTable->GetMaterialCutsCouple(j)->GetMaterial();
+      const G4ElementVector* elV = mat->GetElementVector();
+      std::size_t numOfElem = mat->GetNumberOfElements();
+      for (std::size_t ie = 0; ie < numOfElem; ++ie) {
+	G4int Z = (*elV)[ie]->GetZasInt();
+	if ((!element_tables || element_tables->count(Z) == 0) &&
+	    std::find(missing.begin(), missing.end(), Z) == missing.end()) {
+	  missing.push_back(Z);
+	}
+      }
+    }
+    if (!missing.empty()) {
+      // a new set, workers may still hold the one of a previous run
+      auto tables = element_tables ? std::make_shared<ElementTables>(*element_tables)
+                                   : std::make_shared<ElementTables>();
+      for (G4int Z : missing) {
+	ElementData data;
+	// Load the ionisation energies
+	if (!load_ionisation_energies(Z, data.binding)) continue;
+	data.bmin = *(std::min_element(data.binding.begin(), data.binding.end()));
+	build_secondary_table(data.binding, data.secondary);
+	data.xs = build_cross_section_table(data.binding, Z);
+	if (validate_tables) {
+	  validate_cross_section_table(data.binding, Z, data.xs);
+	  validate_secondary_table(data.binding, Z, data.secondary);
+	}
+	(*tables)[Z] = std::move(data);
+      }
+      element_tables = tables;
+    }
+    // angular sampling table, shared by all threads
+    QTNMIonisationAngles::Instance();
+    // will make use of the cross sections so the above needs to be done before
     InitialiseElementSelectors(pdef, prodcuts);
   }
 }
@@ -108,10 +132,15 @@ void QTNMeImpactIonisation::InitialiseLocal(const G4ParticleDefinition*,
                                                     G4VEmModel* masterModel)
 {
   SetElementSelectors(masterModel->GetElementSelectors());
+  element_tables = static_cast<QTNMeImpactIonisation*>(masterModel)->element_tables;
+  if (!element_tables) {
+    G4Exception("QTNMeImpactIonisation::InitialiseLocal()", "No Tables", FatalException,
+                "No element tables on the master model.");
+  }
 }
 
 
-// For Z <= 18, use the modified Bell cross-sections
+// For Z <= 18, use the modified Bell cross-sections, tabulated per Z
 // https://doi.org/10.1103/PhysRevA.73.052703
 // https://doi.org/10.1088/0031-8949/74/3/014
 G4double
@@ -127,9 +156,32 @@ QTNMeImpactIonisation::ComputeCrossSectionPerAtom(const G4ParticleDefinition*,
   // Z, int
   G4int z_int = (int) Z;
   if (z_int > z_max) return 0.0;
+  if (exclude_hydrogen && z_int == 1) return 0.0;
+
+  const ElementData* data = nullptr;
+  if (element_tables) {
+    auto it = element_tables->find(z_int);
+    if (it != element_tables->end()) data = &it->second;
+  }
+  G4double sigma = 0.0;
+  if (data) {
+    sigma = data->xs.Value(T_ev);
+  }
+  else { // element not in the geometry, e.g. from G4EmCalculator
+    std::vector<G4double> bind_vals;
+    if (load_ionisation_energies(z_int, bind_vals)) sigma = mbell_cross_section(bind_vals, z_int, T_ev);
+  }
+
+  //  G4cout<< " >> inelastic CS: " << T_ev <<  ", " << sigma << G4endl;
+  return sigma * CLHEP::cm * CLHEP:: cm;
+}
+
 
-  // Get binding energies for material
-  std::vector<G4double> bind_vals = get_ionisation_energies(z_int);
+// Modified Bell cross section per atom [cm^2], summed over shells
+G4double
+QTNMeImpactIonisation::mbell_cross_section(const std::vector<G4double>& bind_vals,
+					   G4int z_int, G4double T_ev) const
+{
   // Number of electrons interior and up to current shell
   G4int n_ele_int = 0;
   G4double sigma = 0;
@@ -182,8 +234,54 @@ QTNMeImpactIonisation::ComputeCrossSectionPerAtom(const G4ParticleDefinition*,
     sigma += n_ele * f_ion * gr * (mbell_a[n-1][l] * std::log(U) + bsum) / (bind * T_ev); // cm^2
   }
 
-  //  G4cout<< " >> inelastic CS: " << T_ev <<  ", " << sigma << G4endl;
-  return sigma * CLHEP::cm * CLHEP:: cm;
+  return sigma;
+}
+
+
+// Cross section on a log(T - bmin) grid from just above the lowest binding
+// energy, where it vanishes, to the model high energy limit
+QTNMeImpactIonisation::CrossSectionTable
+QTNMeImpactIonisation::build_cross_section_table(const std::vector<G4double>& bind_vals,
+						 G4int Z) const
+{
+  CrossSectionTable table;
+  table.bmin = *(std::min_element(bind_vals.begin(), bind_vals.end()));
+  const G4double umin = 1e-4 * table.bmin;
+  const G4double umax = HighEnergyLimit() / CLHEP::eV;
+
+  table.dlogU   = std::log(10.0) / nXSPerDecade;
+  table.logUmin = std::log(umin);
+  table.nT      = std::max(2, (G4int)std::ceil(std::log(umax/umin) / table.dlogU) + 1);
+  table.sigma.resize(table.nT);
+  for (G4int k = 0; k < table.nT; ++k) {
+    table.sigma[k] = mbell_cross_section(bind_vals, Z, table.bmin + std::exp(table.logUmin + k*table.dlogU));
+  }
+  return table;
+}
+
+
+// Validation mode: table against analytic formula at all bin centres,
+// the largest interpolation error
+void
+QTNMeImpactIonisation::validate_cross_section_table(const std::vector<G4double>& bind_vals,
+						    G4int Z, const CrossSectionTable& table) const
+{
+  G4double maxdev = 0.0, sumdev = 0.0, emax = 0.0;
+  for (G4int k = 0; k < table.nT - 1; ++k) {
+    G4double T_ev  = table.bmin + std::exp(table.logUmin + (k + 0.5)*table.dlogU);
+    G4double exact = mbell_cross_section(bind_vals, Z, T_ev);
+    if (exact <= 0.0) continue;
+    G4double dev = std::abs(table.Value(T_ev) / exact - 1.0);
+    sumdev += dev;
+    if (dev > maxdev) {
+      maxdev = dev;
+      emax   = T_ev;
+    }
+  }
+  G4cout << "QTNMeImpactIonisation: Z = " << Z << " cross section table, "
+	 << table.nT << " nodes above " << table.bmin << " eV, "
+	 << "relative deviation from modified Bell formula: max " << maxdev
+	 << " at " << emax << " eV, mean " << sumdev / (table.nT - 1) << G4endl;
 }
 
 
@@ -206,6 +304,59 @@ QTNMeImpactIonisation::SampleSecondaries(std::vector<G4DynamicParticle*>* fvect,
 
   const G4double T_ev = ekin / CLHEP::eV;
 
+  // element tables, exist for all elements with non-zero cross section
+  const ElementData& data = element_tables->at(izet);
+  const std::vector<G4double>& bind_vals = data.binding;
+  const G4double bmin = data.bmin;
+
+  G4double enew = sample_secondary_energy(data.secondary, bmin, T_ev,
+					  QTRandom::Flat(QTRandom::kIonisation));
+
+  // Original direction of particle in lab frame
+  G4ThreeVector dir_lab = dp->GetMomentumDirection();
+
+  // Primary energy post collision
+  G4double prim_new = T_ev - enew - bind_vals[0];
+  G4double w = prim_new / bind_vals[0];
+  G4double t = T_ev / bind_vals[0];
+  const QTNMIonisationAngles& angles = QTNMIonisationAngles::Instance();
+
+  // Deflection of primary particle
+  G4double cost = std::cos(angles.SampleTheta(w, t, QTRandom::Flat(QTRandom::kIonisation),
+					      QTRandom::Flat(QTRandom::kIonisation)));
+  G4double sint = std::sqrt((1.0-cost)*(1.0+cost));
+  G4double phi  = CLHEP::twopi*QTRandom::Flat(QTRandom::kIonisation);
+  G4ThreeVector theNewDirection(sint*std::cos(phi), sint*std::sin(phi), cost);
+
+  // get original direction in lab frame and rotate new direction to lab frame
+  theNewDirection.rotateUz(dir_lab);
+
+  // Set new direction
+  fParticleChange->ProposeMomentumDirection(theNewDirection);
+  // Reduce kinetic energy
+  fParticleChange->SetProposedKineticEnergy(prim_new * CLHEP::eV);
+  fParticleChange->ProposeLocalEnergyDeposit(bind_vals[0] * CLHEP::eV);
+
+  // Add secondary particle
+
+  w = enew / bind_vals[0];
+  cost = std::cos(angles.SampleTheta(w, t, QTRandom::Flat(QTRandom::kIonisation),
+				     QTRandom::Flat(QTRandom::kIonisation)));
+  sint = std::sqrt((1.0-cost)*(1.0+cost));
+  phi  = CLHEP::twopi*QTRandom::Flat(QTRandom::kIonisation);
+  theNewDirection.set(sint*std::cos(phi), sint*std::sin(phi), cost);
+  theNewDirection.rotateUz(dir_lab);
+  auto newp = new G4DynamicParticle (G4Electron::Electron(), theNewDirection, enew * CLHEP::eV);
+  fvect->push_back(newp);
+
+}
+
+// Unnormalised RBEB CDF at the nESpace secondary energies for incident
+// energy T_ev, summed over shells
+void
+QTNMeImpactIonisation::secondary_cdf(const std::vector<G4double>& bind_vals,
+				     G4double T_ev, G4double* cdf) const
+{
   // Incident energy dependent terms
   const G4double mc2_ev = 511e3;
   const G4double t_prime = T_ev / mc2_ev;
@@ -215,17 +366,11 @@ QTNMeImpactIonisation::SampleSecondaries(std::vector<G4DynamicParticle*>* fvect,
   const G4double alpha = CLHEP::fine_structure_const;
   const G4double aB = 5.29e-11;
 
-  std::vector<G4double> cdf(nESpace);
-
-  std::vector<G4double> bind_vals = get_ionisation_energies(izet);
-
-  // Maximum energy of secondary particle
-  const G4double emax = 0.5 * (T_ev - *(std::min_element(bind_vals.begin(), bind_vals.end())));
-  secondary_energy = logspace(std::log10(1e-6*T_ev), std::log10(emax), nESpace);
-
+  const G4double bmin = *(std::min_element(bind_vals.begin(), bind_vals.end()));
   const G4int nShells = bind_vals.size();
 
   for (G4int i = 0; i < nESpace; i++) {
+    const G4double energy = secondary_energy(T_ev, bmin, i);
     G4double cdf_sum = 0.0;
     for (G4int j = 0; j <nShells; ++j) {
       G4double bind = bind_vals[j];
@@ -234,7 +379,7 @@ QTNMeImpactIonisation::SampleSecondaries(std::vector<G4DynamicParticle*>* fvect,
       //RBEB terms
       G4double b_prime = bind / mc2_ev;
       G4double t = T_ev / bind;
-      G4double w = secondary_energy[i] / bind;
+      G4double w = energy / bind;
       G4double beta_b2 = 1 - 1./ pow(1 + b_prime, 2);
       G4double beta2 = beta_t2 + 2*beta_b2;
 
@@ -254,93 +399,153 @@ QTNMeImpactIonisation::SampleSecondaries(std::vector<G4DynamicParticle*>* fvect,
     }
     cdf[i] = cdf_sum;
   }
+}
 
-  // Normalise
-  for (int i = 0; i < nESpace; i++) {
-   cdf[i] /= cdf[nESpace-1];
-  }
-
-  CLHEP::HepRandomEngine* rndmEngine = G4Random::getTheEngine();
-  G4double rndm = rndmEngine->flat();
-
-  auto lower = std::lower_bound(cdf.begin(), cdf.end(), rndm);
-
-  G4double fac1 = (*lower - rndm) / (*lower - *(lower-1));
-  G4double fac2 = 1.0 - fac1;
-
-  G4int i2 = std::distance(cdf.begin(), lower);
-  G4double enew = fac1 * secondary_energy[i2-1] + fac2 * secondary_energy[i2];
-
-  // Original direction of particle in lab frame
-  G4ThreeVector dir_lab = dp->GetMomentumDirection();
-
-  // Primary energy post collision
-  G4double prim_new = T_ev - enew - bind_vals[0];
-  G4double w = prim_new / bind_vals[0];
-  G4double t = T_ev / bind_vals[0];
-  for (G4int i = 1; i < nAngles; i++) {
-    angle_pdf[i] = fbe(w, t, angle[i]) + fb(w, t, angle[i]);
-  }
-
-  std::piecewise_constant_distribution<> dist(angle.begin(),
-					      angle.end(),
-					      angle_pdf.begin());
-
-  // Deflection of primary particle
-  G4double cost = std::cos(dist(generator));
-  G4double sint = std::sqrt((1.0-cost)*(1.0+cost));
-  G4double phi  = CLHEP::twopi*rndmEngine->flat();
-  G4ThreeVector theNewDirection(sint*std::cos(phi), sint*std::sin(phi), cost);
-
-  // get original direction in lab frame and rotate new direction to lab frame
-  theNewDirection.rotateUz(dir_lab);
-
-  // Set new direction
-  fParticleChange->ProposeMomentumDirection(theNewDirection);
-  // Reduce kinetic energy
-  fParticleChange->SetProposedKineticEnergy(prim_new * CLHEP::eV);
-  fParticleChange->ProposeLocalEnergyDeposit(bind_vals[0] * CLHEP::eV);
-
-  // Add secondary particle
+// Secondary energy [eV] at fractional index pos of the log spaced grid
+// [min(1e-6 T, 1e-2 bmin), (T - bmin)/2], linear in energy between grid
+// points and the grid continued below the first point for pos < 0. The
+// lower edge stays below the binding energies, where the density is flat,
+// up to the model high energy limit
+G4double
+QTNMeImpactIonisation::secondary_energy(G4double T_ev, G4double bmin, G4double pos) const
+{
+  const G4double a = std::log(std::min(1e-6*T_ev, 1e-2*bmin));
+  const G4double b = std::log(0.5 * (T_ev - bmin));
+  const G4double fac = (b - a) / (nESpace - 1);
+  if (pos < 0.0) return std::exp(a + pos*fac);
+  G4int i = std::min((G4int)pos, nESpace - 2);
+  G4double f = pos - i;
+  G4double e = std::exp(a + i*fac);
+  return (f > 0.0) ? e * ((1.0 - f) + f*std::exp(fac)) : e;
+}
 
-  w = enew / bind_vals[0];
-  for (G4int i = 1; i < angle.size(); i++) {
-    angle_pdf[i] = fbe(w, t, angle[i]) + fb(w, t, angle[i]);
+// Fractional grid index where the normalised CDF reaches rndm. Below the
+// first grid point the CDF continues as the power law in energy through
+// the first two, the index is then negative
+G4double
+QTNMeImpactIonisation::sample_secondary_position(const G4double* cdf, G4double rndm) const
+{
+  const G4double* lower = std::lower_bound(cdf, cdf + nESpace, rndm);
+  if (lower == cdf) {
+    if (cdf[1] <= cdf[0] || rndm <= 0.0) return 0.0;
+    return cdf[0] * std::log(rndm / cdf[0]) / (cdf[1] - cdf[0]);
   }
-
-  std::piecewise_constant_distribution<> dist2(angle.begin(),
-					       angle.end(),
-					       angle_pdf.begin());
-
-  cost = std::cos(dist2(generator));
-  sint = std::sqrt((1.0-cost)*(1.0+cost));
-  phi  = CLHEP::twopi*rndmEngine->flat();
-  theNewDirection.set(sint*std::cos(phi), sint*std::sin(phi), cost);
-  theNewDirection.rotateUz(dir_lab);
-  auto newp = new G4DynamicParticle (G4Electron::Electron(), theNewDirection, enew * CLHEP::eV);
-  fvect->push_back(newp);
-
+  if (lower == cdf + nESpace) return nESpace - 1;
+  G4double fac2 = (rndm - *(lower-1)) / (*lower - *(lower-1));
+  return (lower - cdf) - 1 + fac2;
 }
 
+// Inverse CDF at the two neighbouring nodes with the same random number,
+// secondary energy [eV] interpolated in log between the node energies,
+// linear in log(T - bmin)
 G4double
-QTNMeImpactIonisation::fbe(G4double w, G4double t, G4double theta)
+QTNMeImpactIonisation::sample_secondary_energy(const SecondaryTable& table, G4double bmin,
+					       G4double T_ev, G4double rndm) const
 {
-  G4double G2 = std::sqrt((w+1)/t);
-  G4double G3 = 0.6 * std::sqrt((1 - pow(G2,2)) / w);
-  return 1.0 / pow(1.0 + (std::cos(theta) - G2) / G3, 2);
+  G4double aT;
+  const G4int iT = table.Node((T_ev > bmin) ? std::log(T_ev - bmin) : table.logTmin, aT);
+  const G4double T0 = bmin + std::exp(table.logU[iT]);
+  const G4double T1 = bmin + std::exp(table.logU[iT+1]);
+  const G4double e0 = secondary_energy(T0, bmin, sample_secondary_position(&table.cdf[iT*nESpace], rndm));
+  const G4double e1 = secondary_energy(T1, bmin, sample_secondary_position(&table.cdf[(iT+1)*nESpace], rndm));
+  // below the first node the node energies exceed the kinematic limit
+  return std::min(std::exp((1.0 - aT)*std::log(e0) + aT*std::log(e1)), 0.5*(T_ev - bmin));
 }
 
-G4double
-QTNMeImpactIonisation::fb(G4double w, G4double t, G4double theta)
+// Validation mode: table sampling against inversion of the CDF computed
+// at the incident energy, midway between all nodes and for rndm in
+// steps of 0.01. The CDF jumps where a shell opens, the pair of nodes
+// bracketing each threshold is skipped
+void
+QTNMeImpactIonisation::validate_secondary_table(const std::vector<G4double>& bind_vals,
+						G4int Z, const SecondaryTable& table) const
+{
+  const G4double bmin = *(std::min_element(bind_vals.begin(), bind_vals.end()));
+  std::vector<G4double> cdf(nESpace);
+  G4double maxdev = 0.0, sumdev = 0.0, emax = 0.0;
+  G4int n = 0;
+  for (G4int k = 0; k < table.nT - 1; ++k) {
+    if (table.logU[k+1] - table.logU[k] < 1e-6) continue;
+    G4double T_ev = bmin + std::exp(0.5*(table.logU[k] + table.logU[k+1]));
+    secondary_cdf(bind_vals, T_ev, cdf.data());
+    const G4double norm = cdf[nESpace-1];
+    for (G4int i = 0; i < nESpace; i++) {
+      cdf[i] /= norm;
+    }
+    for (G4int r = 1; r < 100; ++r) {
+      G4double exact = secondary_energy(T_ev, bmin, sample_secondary_position(cdf.data(), 0.01*r));
+      G4double dev   = std::abs(sample_secondary_energy(table, bmin, T_ev, 0.01*r) / exact - 1.0);
+      sumdev += dev;
+      ++n;
+      if (dev > maxdev) {
+	maxdev = dev;
+	emax   = T_ev;
+      }
+    }
+  }
+  G4cout << "QTNMeImpactIonisation: Z = " << Z << " secondary energy table, "
+	 << table.nT << " nodes above " << bmin << " eV, "
+	 << "relative deviation from CDF inversion: max " << maxdev
+	 << " at " << emax << " eV, mean " << sumdev / std::max(n, 1) << G4endl;
+}
+
+// Normalised secondary energy CDFs for element Z on a grid in log(T - bmin),
+// fine close to threshold where the CDF changes fastest, up to the model
+// high energy limit. Each inner shell opens with a jump in the CDF: nodes
+// just below and above its threshold, none interpolates across it, and a
+// log grid in T - bind above it
+void
+QTNMeImpactIonisation::build_secondary_table(const std::vector<G4double>& bind_vals,
+					     SecondaryTable& table) const
 {
-  G4double G5 = 1.0 / 3.0;
-  G4double gamma = 10.0;
-  G4double G4 = gamma * pow(1 - w/t,3) / t / (w + 1);
-  return G4 / pow(1.0 + (std::cos(theta) + 1) / G5, 2);
+  const G4double bmin = *(std::min_element(bind_vals.begin(), bind_vals.end()));
+
+  const G4double umin = 1e-4 * bmin; // T - bmin, maximum secondary energy > 1e-6 T
+  const G4double umax = HighEnergyLimit() / CLHEP::eV;
+  table.dlogT   = std::log(10.0) / nTPerDecade;
+  table.logTmin = std::log(umin);
+  const G4int nUniform = std::max(2, (G4int)std::ceil(std::log(umax/umin) / table.dlogT) + 1);
+
+  std::vector<G4double>& logU = table.logU;
+  logU.resize(nUniform);
+  for (G4int k = 0; k < nUniform; ++k) {
+    logU[k] = table.logTmin + k*table.dlogT;
+  }
+  for (G4double bind : bind_vals) {
+    const G4double u = bind - bmin;
+    if (u <= umin || u >= umax) continue;
+    // either side of the threshold, clear of rounding in bmin + exp(logU)
+    logU.push_back(std::log(u) + std::log1p(-1e-9));
+    logU.push_back(std::log(u) + std::log1p(1e-9));
+    for (G4int m = 0; m <= 4*nAbovePerDecade; ++m) {
+      const G4double v = u + bind*std::pow(10.0, -5.0 + (G4double)m/nAbovePerDecade);
+      if (v < umax) logU.push_back(std::log(v));
+    }
+  }
+  std::sort(logU.begin(), logU.end());
+  logU.erase(std::unique(logU.begin(), logU.end()), logU.end());
+  table.nT = (G4int)logU.size();
+
+  // uniform grid point k to its index among all nodes, for the lookup
+  table.first.resize(nUniform);
+  for (G4int k = 0, n = 0; k < nUniform; ++k) {
+    while (logU[n] < table.logTmin + k*table.dlogT - 1e-12) ++n;
+    table.first[k] = n;
+  }
+
+  table.cdf.resize(table.nT * nESpace);
+  for (G4int k = 0; k < table.nT; ++k) {
+    G4double* cdf = &table.cdf[k*nESpace];
+    secondary_cdf(bind_vals, bmin + std::exp(logU[k]), cdf);
+    const G4double norm = cdf[nESpace-1];
+    for (G4int i = 0; i < nESpace; i++) {
+      cdf[i] /= norm;
+    }
+  }
 }
 
 G4double
-QTNMeImpactIonisation::mbell_gr(G4double U, G4double J)
+QTNMeImpactIonisation::mbell_gr(G4double U, G4double J) const
 {
   G4double a = (1.0 + 2.0*J) / (U + 2.0*J);
   G4double b = pow( (U + J) / (1.0 + J), 2);
@@ -349,28 +554,15 @@ QTNMeImpactIonisation::mbell_gr(G4double U, G4double J)
 }
 
 G4double
-QTNMeImpactIonisation::mbell_f_ion(G4int z_eff, G4double U, G4int Z, G4double m_lambda)
+QTNMeImpactIonisation::mbell_f_ion(G4int z_eff, G4double U, G4int Z, G4double m_lambda) const
 {
   return 1 + mbell_m * pow( z_eff/(U*Z), m_lambda);
 }
 
 
-std::vector<G4double>
-QTNMeImpactIonisation::logspace(const G4double a, const G4double b, const G4int n)
+G4bool
+QTNMeImpactIonisation::load_ionisation_energies(G4int Z, std::vector<G4double>& bind_vals) const
 {
-  std::vector<G4double> _logspace;
-  _logspace.reserve(nESpace);
-  const G4double fac = (b - a) / (n - 1);
-  for (int i = 0; i < n; i++) {
-    _logspace.push_back(pow(10, i * fac + a));
-  }
-  return _logspace;
-}
-
-void
-QTNMeImpactIonisation::load_ionisation_energies(G4int Z)
-{
-  if (binding_energies.count(Z) > 0) return;
   if (Z > z_max) {
     std::ostringstream msg;
     msg << "Impact ionisation cross section unavailable for Z  = "
@@ -378,30 +570,10 @@ QTNMeImpactIonisation::load_ionisation_energies(G4int Z)
 	<< ". Cross section will be set to 0.0";
     G4Exception("QTNMeImpactIonisation::load_ionisation_energies:",
 		"No Cross Section", JustWarning, msg);
-    return;
+    return false;
   }
-  auto fname = project_root + "/src/tables/binding_energy/be_" + std::to_string(Z);
-  std::ifstream input(fname);
-  if (!input.is_open()) {
-    G4String msg  =
-      "    Problem while trying to read " + fname + " file.\n";
-    G4Exception("QTNMeImpactIonisation::ReadFile","em0006",
-                FatalException,msg.c_str());
-    return;
-  }
-  // Skip Header
-  input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-  std::string line;
-  while (std::getline(input >> std::ws, line))
-    {
-      // Skip first character, the ionisation level
-      std::istringstream iss(line.substr(1, line.size()-1));
-      // Convert remaining numbers into a vector, and delete 0 elements.
-      std::vector<G4double> elevels = std::vector<double>{std::istream_iterator<double>(iss), std::istream_iterator<double>()};
-      elevels.erase(std::remove(elevels.begin(), elevels.end(), 0.0), elevels.end());
-      binding_energies[Z] = elevels;
-      // Could at this stage read in levels for ions
-      // but break instead
-      break;
-    }
+  // compiled in from src/tables/binding_energy, no file access
+  const QTNMBindingEnergies::Element& elm = QTNMBindingEnergies::table[Z];
+  bind_vals.assign(elm.energy, elm.energy + elm.nshells);
+  return true;
 }
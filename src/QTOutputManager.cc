@@ -1,6 +1,10 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 #include "QTOutputManager.hh"
+#include "QTGasHit.hh"
+#include "QTHdf5Manager.hh"
+#include "QTColumnStore.hh"
+#include "QTSegmentStore.hh"
 
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
@@ -14,15 +18,47 @@ QTOutputManager::QTOutputManager(G4String fname)
   // Create or get analysis manager
   analysisManager = G4AnalysisManager::Instance();
   analysisManager->SetDefaultFileType("root");
+
+  // columnar output selected by file extension
+  if (QTHdf5Manager::IsHdf5FileName(fout)) hdf5Manager = new QTHdf5Manager();
 }
 
 // leave deleting to run manager, follows AnaEx01
 
-QTOutputManager::~QTOutputManager() = default;
+QTOutputManager::~QTOutputManager()
+{
+  delete hdf5Manager;
+}
+
+
+inline void QTOutputManager::FillI(G4int which, G4int col, G4int val)
+{
+  if (hdf5Manager) hdf5Manager->FillNtupleIColumn(which, col, val);
+  else             analysisManager->FillNtupleIColumn(which, col, val);
+}
+
+
+inline void QTOutputManager::FillD(G4int which, G4int col, G4double val)
+{
+  if (hdf5Manager) hdf5Manager->FillNtupleDColumn(which, col, val);
+  else             analysisManager->FillNtupleDColumn(which, col, val);
+}
+
+
+inline void QTOutputManager::AddRow(G4int which)
+{
+  if (hdf5Manager) hdf5Manager->AddNtupleRow(which);
+  else             analysisManager->AddNtupleRow(which);
+}
 
 
 void QTOutputManager::Book()
 {
+  if (hdf5Manager) { // columnar HDF5 output
+    BookNtuples(hdf5Manager);
+    return;
+  }
+
   // Create or get analysis manager
   analysisManager = G4AnalysisManager::Instance();
 
@@ -34,9 +70,16 @@ void QTOutputManager::Book()
     analysisManager->SetNtupleDirectoryName("ntuple");
   }
 
-  // Open an output file
+  BookNtuples(analysisManager);
+}
+
+
+template <class M>
+void QTOutputManager::BookNtuples(M* mgr)
+{
+  // Open an output file, one per segment pass
   //
-  G4bool fileOpen = analysisManager->OpenFile(fout);
+  G4bool fileOpen = mgr->OpenFile(QTSegmentStore::Instance().PassFileName(fout));
   if (! fileOpen) {
     G4cerr << "\n---> OutputManager::Book(): cannot open "
            << GetFileName() << G4endl;
@@ -49,19 +92,20 @@ void QTOutputManager::Book()
     
     // Creating ntuple 0 with number entries
     //
-    analysisManager->CreateNtuple("Score", "Hits");
-    analysisManager->CreateNtupleIColumn("EventID");
-    analysisManager->CreateNtupleIColumn("TrackID");
-    analysisManager->CreateNtupleDColumn("Edep");
-    analysisManager->CreateNtupleDColumn("TimeStamp");
-    analysisManager->CreateNtupleDColumn("PreKine");
-    analysisManager->CreateNtupleDColumn("PostKine");
-    analysisManager->CreateNtupleDColumn("PreTheta");
-    analysisManager->CreateNtupleDColumn("PostTheta");
-    analysisManager->CreateNtupleDColumn("Posx");
-    analysisManager->CreateNtupleDColumn("Posy");
-    analysisManager->CreateNtupleDColumn("Posz");
-    analysisManager->FinishNtuple();
+    mgr->CreateNtuple("Score", "Hits");
+    mgr->CreateNtupleIColumn("EventID");
+    mgr->CreateNtupleIColumn("TrackID");
+    mgr->CreateNtupleDColumn("Edep");
+    mgr->CreateNtupleDColumn("TimeStamp");
+    mgr->CreateNtupleDColumn("PreKine");
+    mgr->CreateNtupleDColumn("PostKine");
+    mgr->CreateNtupleDColumn("PreTheta");
+    mgr->CreateNtupleDColumn("PostTheta");
+    mgr->CreateNtupleDColumn("Posx");
+    mgr->CreateNtupleDColumn("Posy");
+    mgr->CreateNtupleDColumn("Posz");
+    mgr->CreateNtupleDColumn("Weight"); // event weight
+    mgr->FinishNtuple();
     
     // Creating ntuple 1 with vector entries
     //
@@ -71,23 +115,24 @@ void QTOutputManager::Book()
     G4String ovecname = "OmVec";
     G4String kvecname = "KEVec";
     G4String stname   = "SourceTime";
-    analysisManager->CreateNtuple("Signal", "Time-series");
-    analysisManager->CreateNtupleIColumn("EventID");
-    analysisManager->CreateNtupleIColumn("TrackID");
-    analysisManager->CreateNtupleDColumn("Posx"); // single starter values
-    analysisManager->CreateNtupleDColumn("Posy"); // for each trajectory
-    analysisManager->CreateNtupleDColumn("Posz"); // vertex position and
-    analysisManager->CreateNtupleDColumn("PitchAngle"); // pitch angle wrt z-axis
-    analysisManager->CreateNtupleDColumn("KinEnergy"); // kinetic energy
+    mgr->CreateNtuple("Signal", "Time-series");
+    mgr->CreateNtupleIColumn("EventID");
+    mgr->CreateNtupleIColumn("TrackID");
+    mgr->CreateNtupleDColumn("Posx"); // single starter values
+    mgr->CreateNtupleDColumn("Posy"); // for each trajectory
+    mgr->CreateNtupleDColumn("Posz"); // vertex position and
+    mgr->CreateNtupleDColumn("PitchAngle"); // pitch angle wrt z-axis
+    mgr->CreateNtupleDColumn("KinEnergy"); // kinetic energy
+    mgr->CreateNtupleDColumn("Weight"); // event weight
     // These need passing a reference to the vector
     // filled by AddNtupleRow() assumed
-    analysisManager->CreateNtupleIColumn(aidname, GetAntennaID());
-    analysisManager->CreateNtupleDColumn(tvecname, GetTimeVec());
-    analysisManager->CreateNtupleDColumn(vvecname, GetVoltageVec());
-    analysisManager->CreateNtupleDColumn(ovecname, GetOmVec());
-    analysisManager->CreateNtupleDColumn(kvecname, GetKEVec());
-    analysisManager->CreateNtupleDColumn(stname, GetSourceTime());
-    analysisManager->FinishNtuple();
+    mgr->CreateNtupleIColumn(aidname, GetAntennaID());
+    mgr->CreateNtupleDColumn(tvecname, GetTimeVec());
+    mgr->CreateNtupleDColumn(vvecname, GetVoltageVec());
+    mgr->CreateNtupleDColumn(ovecname, GetOmVec());
+    mgr->CreateNtupleDColumn(kvecname, GetKEVec());
+    mgr->CreateNtupleDColumn(stname, GetSourceTime());
+    mgr->FinishNtuple();
 
     fFactoryOn = true;
   }
@@ -96,11 +141,18 @@ void QTOutputManager::Book()
 
 void QTOutputManager::Save()
 {
+  if (! fFactoryOn) { return; }
+
+  if (hdf5Manager) {
+    hdf5Manager->Write();
+    hdf5Manager->CloseFile();
+    hdf5Manager->Clear();
+    return;
+  }
+
   // Create or get analysis manager
   analysisManager = G4AnalysisManager::Instance();
 
-  if (! fFactoryOn) { return; }
-  
   analysisManager->Write();
   analysisManager->CloseFile();
   analysisManager->Clear();
@@ -109,28 +161,69 @@ void QTOutputManager::Save()
 
 void QTOutputManager::FillNtupleI(G4int which, G4int col, G4int val)
 {
-  // Create or get analysis manager
-  analysisManager = G4AnalysisManager::Instance();
-
-  analysisManager->FillNtupleIColumn(which, col, val);
+  FillI(which, col, val);
 }
 
 
 void QTOutputManager::FillNtupleD(G4int which, G4int col, G4double val)
 {
-  // Create or get analysis manager
-  analysisManager = G4AnalysisManager::Instance();
+  FillD(which, col, val);
+}
+
 
-  analysisManager->FillNtupleDColumn(which, col, val);
+void QTOutputManager::FillSignalColumns(QTColumnStore* store)
+{
+  // exchange buffers with the booked vectors; references held by
+  // the ntuple stay valid. Store receives the cleared buffers.
+  avec.swap(store->GetAntennaID());
+  tvec.swap(store->GetTime());
+  vvec.swap(store->GetVoltage());
+  ovec.swap(store->GetOm());
+  kvec.swap(store->GetKE());
+  stvec.swap(store->GetST());
 }
 
 
-void QTOutputManager::AddNtupleRow(G4int which)
+void QTOutputManager::AddScoreRow(G4int eventID, G4double weight, const QTGasHit* hit)
 {
-  // Create or get analysis manager
-  analysisManager = G4AnalysisManager::Instance();
+  FillI(fScoreID, kEventID, eventID);
+  FillI(fScoreID, kTrackID, hit->GetTrackID());
+  FillD(fScoreID, kEdep, hit->GetEdep() * fPerkeV);
+  FillD(fScoreID, kTimeStamp, hit->GetTime() * fPerns);
+  FillD(fScoreID, kPreKine, hit->GetPreKine() * fPerkeV);
+  FillD(fScoreID, kPostKine, hit->GetPostKine() * fPerkeV);
+  FillD(fScoreID, kPreTheta, hit->GetPreTheta()); // pitch angle
+  FillD(fScoreID, kPostTheta, hit->GetPostTheta());
+  FillD(fScoreID, kPosx, hit->GetPosx()); // interaction location
+  FillD(fScoreID, kPosy, hit->GetPosy());
+  FillD(fScoreID, kPosz, hit->GetPosz());
+  FillD(fScoreID, kWeight, weight);
+  AddRow(fScoreID);
+}
+
 
-  analysisManager->AddNtupleRow(which);
+void QTOutputManager::AddStopRow(G4int eventID, G4double weight, const QTGasHit* hit)
+{
+  // stop time and location only
+  FillI(fScoreID, kEventID, eventID);
+  FillI(fScoreID, kTrackID, hit->GetTrackID());
+  FillD(fScoreID, kEdep, 0.0);
+  FillD(fScoreID, kTimeStamp, hit->GetTime() * fPerns);
+  FillD(fScoreID, kPreKine, 0.0);
+  FillD(fScoreID, kPostKine, 0.0);
+  FillD(fScoreID, kPreTheta, 0.0);
+  FillD(fScoreID, kPostTheta, 0.0);
+  FillD(fScoreID, kPosx, hit->GetPosx());
+  FillD(fScoreID, kPosy, hit->GetPosy());
+  FillD(fScoreID, kPosz, hit->GetPosz());
+  FillD(fScoreID, kWeight, weight);
+  AddRow(fScoreID);
+}
+
+
+void QTOutputManager::AddNtupleRow(G4int which)
+{
+  AddRow(which);
 
   // clear internal vector storage after writing to disk with this method.
   avec.clear();
@@ -1,10 +1,17 @@
 // us
 #include "QTPrimaryGeneratorAction.hh"
+#include "TBetaGenerator.hh"
+#include "QTRandom.hh"
+#include "QTEventCost.hh"
 
 #include <cmath>
 
 // geant
 #include "G4Event.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
 #include "G4ThreeVector.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4ParticleGun.hh"
@@ -16,20 +23,20 @@
 #include "G4LogicalVolume.hh"
 #include "G4Box.hh"
 #include "G4Tubs.hh"
-#include "G4RandomTools.hh"
-#include "G4RandomDirection.hh"
 
 
-QTPrimaryGeneratorAction::QTPrimaryGeneratorAction()
+QTPrimaryGeneratorAction::QTPrimaryGeneratorAction(G4int firstEvent)
 : G4VUserPrimaryGeneratorAction()
 , fParticleGun(nullptr)
 , fParticleGPS(nullptr)
 , fMessenger(nullptr)
+, fFirstEvent(firstEvent)
 , fMean(18.575) // energy [keV]
 , fStdev(5.e-4) // for E-gun
 , fSpot(0.5)    // for E-gun
 , fTritium(false) // switch to Trtium beta decay generator
 , fBespokeTritium(false) // no Tritium source specs
+, fContinuum(false) // no continuum orbital states in spectrum
 , fEGun(false) // calibration: true=electron gun
 , fTestElectron(false)  // 90 degree electron for testing, override other guns
 , fOrder(true)   // neutrino hierarchie: true=normal
@@ -40,9 +47,11 @@ QTPrimaryGeneratorAction::QTPrimaryGeneratorAction()
 , fQminusThis(0.2)  // no energy lower bound [keV] from Q-value
 , fAngleLow(0.0)  // pitch angle [deg] lower bound, default unused
 , fAngleHigh(90.0)  // pitch angle [deg] high bound, default unused
+, fTableCache("")  // no beta spectrum tables on disk
+, fBiasFactor(0.0) // no endpoint importance sampling
+, fBiasWidth(0.01) // endpoint bias decay length [keV]
+, fVertexFileName("") // no vertex file
 {
-  generator.seed(rd()); // using random seed
-
   G4int nofParticles = 1;
   fParticleGun       = new G4ParticleGun(nofParticles);
   fParticleGPS       = new G4GeneralParticleSource(); // can now be used with macro commands
@@ -70,6 +79,64 @@ QTPrimaryGeneratorAction::~QTPrimaryGeneratorAction()
 }
 
 void QTPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
+{
+  // event of this run to process next, longest first if costs are known
+  event->SetEventID(QTEventCost::Instance().Slot(event->GetEventID()));
+
+  // continuation of a time segmented primary, see QTSegmentStore
+  QTSegmentStore& segments = QTSegmentStore::Instance();
+  if (segments.GetPass() > 0) {
+    GenerateSegment(event, segments.GetPending(event->GetEventID()));
+    return;
+  }
+
+  GenerateVertex(event);
+
+  // segment 0, the vertex is kept for the output row of the last segment
+  if (segments.IsActive() && event->GetNumberOfPrimaryVertex() > 0) {
+    const G4PrimaryVertex*   vertex  = event->GetPrimaryVertex();
+    const G4PrimaryParticle* primary = vertex->GetPrimary();
+    QTSegmentStore::Checkpoint start;
+    start.runID           = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+    start.eventID         = event->GetEventID();
+    start.particle        = primary->GetParticleDefinition();
+    start.position        = vertex->GetPosition();
+    start.direction       = primary->GetMomentumDirection();
+    start.ekin            = primary->GetKineticEnergy();
+    start.time            = vertex->GetT0();
+    start.weight          = vertex->GetWeight();
+    start.vertexPosition  = start.position;
+    start.vertexDirection = start.direction;
+    start.vertexEnergy    = start.ekin;
+    event->SetUserInformation(new QTSegmentInfo(start));
+  }
+}
+
+
+void QTPrimaryGeneratorAction::GenerateSegment(G4Event* event,
+					       const QTSegmentStore::Checkpoint& c)
+{
+  // random numbers from (seed, event ID, segment) as for any event
+  event->SetEventID(c.eventID);
+  QTRandom::BeginEvent(c.runID, c.eventID, c.segment);
+  QTRandom::SeedEngine();
+
+  G4ParticleDefinition* gunParticle = fParticleGun->GetParticleDefinition();
+  fParticleGun->SetParticleDefinition(const_cast<G4ParticleDefinition*>(c.particle));
+  fParticleGun->SetParticlePosition(c.position);
+  fParticleGun->SetParticleMomentumDirection(c.direction);
+  fParticleGun->SetParticleEnergy(c.ekin);
+  fParticleGun->SetParticleTime(c.time);
+  fParticleGun->GeneratePrimaryVertex(event);
+  event->GetPrimaryVertex()->SetWeight(c.weight);
+  fParticleGun->SetParticleTime(0.0);
+  fParticleGun->SetParticleDefinition(gunParticle);
+
+  event->SetUserInformation(new QTSegmentInfo(c));
+}
+
+
+void QTPrimaryGeneratorAction::GenerateVertex(G4Event* event)
 {
   // In order to avoid dependence of PrimaryGeneratorAction
   // on DetectorConstruction class we get world volume
@@ -78,7 +145,15 @@ void QTPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
   // Check: Name requirement for GDML file AND axis assumption!
   // Check: G4Tubs assumption for atom cloud in GDML.
   //
-  using pld_type = std::piecewise_linear_distribution<double>;
+  // global event ID, used by all output. All random numbers of the
+  // event follow from (seed, run ID, event ID), independent of thread
+  // and order
+  event->SetEventID(fFirstEvent + event->GetEventID());
+  QTRandom::BeginEvent(G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID(),
+		       event->GetEventID());
+  QTRandom::SeedEngine(); // Geant4 engine: GPS and physics
+  const G4int stream = QTRandom::kPrimary;
+
   auto worldLV  = G4LogicalVolumeStore::GetInstance()->GetVolume("worldLV");
   auto sourceLV = G4LogicalVolumeStore::GetInstance()->GetVolume("Gas_log");
 
@@ -95,16 +170,53 @@ void QTPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
     G4double worldZHalfLength = worldBox->GetZHalfLength();
 
     // random spot location [mm]
-    G4TwoVector loc = G4RandomPointInEllipse(fSpot/2.0, fSpot/2.0); // circle
-    fParticleGun->SetParticlePosition(G4ThreeVector(loc.x()*mm, loc.y()*mm, -worldZHalfLength + 1.*cm));
+    G4double spotr   = fSpot/2.0 * std::sqrt(QTRandom::Flat(stream)); // uniform in circle
+    G4double spotphi = CLHEP::twopi * QTRandom::Flat(stream);
+    fParticleGun->SetParticlePosition(G4ThreeVector(spotr*std::cos(spotphi)*mm, spotr*std::sin(spotphi)*mm,
+						    -worldZHalfLength + 1.*cm));
     fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.0, 0.0, 1.0)); // z-direction
 
     // Gaussian random energy [keV]
-    G4double en = G4RandGauss::shoot(fMean, fStdev);
+    G4double en = QTRandom::Gauss(stream, fMean, fStdev);
     fParticleGun->SetParticleEnergy(en * keV);
     fParticleGun->GeneratePrimaryVertex(event);
     return;
   }
+  else if (!fVertexFileName.empty()) { // pre-generated vertices
+    if (!fVertexFile || fVertexFile->GetFileName() != fVertexFileName) {
+      fVertexFile   = QTVertexFile::Get(fVertexFileName);
+      fPrefetchFrom = fPrefetchTo = 0;
+    }
+    G4long id = event->GetEventID();
+    if (id >= fVertexFile->Size()) {
+      G4ExceptionDescription msg;
+      msg << "Event " << id << " beyond the " << fVertexFile->Size()
+	  << " vertices in " << fVertexFileName << ".";
+      G4Exception("QTPrimaryGeneratorAction::GeneratePrimaries()", "QTGen001",
+		  RunMustBeAborted, msg);
+      event->SetEventAborted();
+      return;
+    }
+    // events of a thread come in blocks of consecutive IDs: keep a
+    // window ahead of the current vertex in flight. Not so in longest
+    // first order, the mapping then reads on demand
+    if (!QTEventCost::Instance().IsReordered() &&
+        (id < fPrefetchFrom || id + fPrefetchWindow/2 > fPrefetchTo)) {
+      G4long from   = (id < fPrefetchFrom || id > fPrefetchTo) ? id : fPrefetchTo;
+      fPrefetchTo   = id + fPrefetchWindow;
+      fPrefetchFrom = id;
+      fVertexFile->Prefetch(from, fPrefetchTo - from);
+    }
+    const QTVertexFile::Vertex& v = fVertexFile->At(id);
+    fParticleGun->SetParticlePosition(G4ThreeVector(v.x*mm, v.y*mm, v.z*mm));
+    fParticleGun->SetParticleMomentumDirection(G4ThreeVector(v.dx, v.dy, v.dz).unit());
+    fParticleGun->SetParticleEnergy(v.ekin * keV);
+    fParticleGun->SetParticleTime(v.time * ns);
+    fParticleGun->GeneratePrimaryVertex(event);
+    event->GetPrimaryVertex()->SetWeight(v.weight);
+    fParticleGun->SetParticleTime(0.0); // other modes start at zero
+    return;
+  }
   else if (fTritium) {  // use tritium beta decay event generator
 
     // distribution parameter
@@ -116,16 +228,20 @@ void QTPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
       nw = 1000; // smaller energy interval, fewer bins
       fLowerBoundTritium = ubound - fQminusThis;  // keep to [keV]
     }
-    pld_type ed(nw, fLowerBoundTritium, ubound, betaGenerator(fOrder, fNumass,
-							      fSterilemass, fSterilemixing));
+    // tabulate only for a new parameter set, shared between threads
+    QTBetaSampler::Parameters par{fOrder, fNumass, fSterilemass, fSterilemixing,
+				  fLowerBoundTritium, ubound, nw, fContinuum,
+				  fBiasFactor, fBiasWidth};
+    if (!fBetaSampler || !(fBetaSampler->GetParameters() == par))
+      fBetaSampler = QTBetaSampler::Get(par, fTableCache);
 
     // random vertex location in atom cloud [mm]
     G4Tubs* atomTubs = dynamic_cast<G4Tubs*>(sourceLV->GetSolid()); // assume a cylinder
     G4double atomZHalfLength = atomTubs->GetZHalfLength();
     G4double atomRadius      = atomTubs->GetOuterRadius();
-    G4double phi             = CLHEP::twopi * G4UniformRand();
-    G4double rad             = G4UniformRand() * atomRadius;
-    G4double zpos            = -atomZHalfLength + 2.0*atomZHalfLength*G4UniformRand();
+    G4double phi             = CLHEP::twopi * QTRandom::Flat(stream);
+    G4double rad             = QTRandom::Flat(stream) * atomRadius;
+    G4double zpos            = -atomZHalfLength + 2.0*atomZHalfLength*QTRandom::Flat(stream);
     fParticleGun->SetParticlePosition(G4ThreeVector(rad*std::cos(phi)*mm, rad*std::sin(phi)*mm, zpos*mm));
     if (fBespokeTritium) { // direction within pitch angle interval
       /// sanity checks
@@ -137,22 +253,31 @@ void QTPrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
       }
       G4double radians;
       if (fAngleLow != fAngleHigh)
-	radians  = CLHEP::RandFlat::shoot(fAngleLow, fAngleHigh) * CLHEP::pi / 180.0; // exclusive upper limit
+	radians  = (fAngleLow + (fAngleHigh-fAngleLow)*QTRandom::Flat(stream)) * CLHEP::pi / 180.0; // exclusive upper limit
       else
 	radians  = fAngleLow * CLHEP::pi / 180.0; // fixed pitch angle, not random
       G4double zz  = std::cos(radians); // cos theta
       G4double rho = std::sqrt(1-zz*zz); // sin theta
-      G4double azi = CLHEP::twopi * G4UniformRand();
+      G4double azi = CLHEP::twopi * QTRandom::Flat(stream);
       G4ThreeVector dir(rho*std::cos(azi), rho*std::sin(azi), zz);
       fParticleGun->SetParticleMomentumDirection(dir); // random angle in interval
     }
-    else
-      fParticleGun->SetParticleMomentumDirection(G4RandomDirection()); // 4 pi solid angle
+    else { // 4 pi solid angle
+      G4double zz  = 2.0*QTRandom::Flat(stream) - 1.0;
+      G4double rho = std::sqrt((1.0-zz)*(1.0+zz));
+      G4double azi = CLHEP::twopi * QTRandom::Flat(stream);
+      fParticleGun->SetParticleMomentumDirection(G4ThreeVector(rho*std::cos(azi), rho*std::sin(azi), zz));
+    }
 
     // Beta decay random energy [keV]
-    G4double en = ed(generator); // this is with std random
+    // draws in sequence, argument evaluation order is unspecified
+    G4double u1 = QTRandom::Flat(stream);
+    G4double u2 = QTRandom::Flat(stream);
+    G4double en = fBetaSampler->Sample(u1, u2);
     fParticleGun->SetParticleEnergy(en * keV);
     fParticleGun->GeneratePrimaryVertex(event);
+    // importance weight, 1 unless endpoint biased
+    event->GetPrimaryVertex()->SetWeight(fBetaSampler->Weight(en));
     return;
   }
   // if nothing else, use the GPS
@@ -190,6 +315,12 @@ void QTPrimaryGeneratorAction::DefineCommands()
   tritCmd.SetParameterName("tttt", true);
   tritCmd.SetDefaultValue("false");
 
+  // tritium spectrum command
+  auto& contCmd = fMessenger->DeclareProperty("continuum", fContinuum,
+					      "Boolean true=include continuum orbital electron states in spectrum.");
+  contCmd.SetParameterName("cont", true);
+  contCmd.SetDefaultValue("false");
+
   // energy command
   auto& energyCmd = fMessenger->DeclareProperty("gunEnergy", fMean,
                                                "Mean Gun energy [keV].");
@@ -266,4 +397,29 @@ void QTPrimaryGeneratorAction::DefineCommands()
   angleHighCmd.SetRange("ahigh>=0.");
   angleHighCmd.SetDefaultValue("90.0");
 
+  // Beta spectrum table cache
+  auto& cacheCmd = fMessenger->DeclareProperty("tableCache", fTableCache,
+					       "Directory for persistent beta spectrum tables, empty=none.");
+  cacheCmd.SetParameterName("dir", true);
+  cacheCmd.SetDefaultValue("");
+
+  // Beta decay endpoint importance sampling
+  auto& biasCmd = fMessenger->DeclareProperty("biasFactor", fBiasFactor,
+					      "Endpoint oversampling b(E)=1+A exp(-(Emax-E)/width), A=0 off; events weighted.");
+  biasCmd.SetParameterName("A", true);
+  biasCmd.SetRange("A>=0.");
+  biasCmd.SetDefaultValue("0.0");
+
+  auto& biasWidthCmd = fMessenger->DeclareProperty("biasWidth", fBiasWidth,
+						   "Endpoint oversampling decay length [keV].");
+  biasWidthCmd.SetParameterName("bw", true);
+  biasWidthCmd.SetRange("bw>0.");
+  biasWidthCmd.SetDefaultValue("0.01");
+
+  // pre-generated vertices
+  auto& vertexCmd = fMessenger->DeclareProperty("vertexFile", fVertexFileName,
+						"QTVTX file of vertices, event i uses vertex i; empty=off.");
+  vertexCmd.SetParameterName("file", true);
+  vertexCmd.SetDefaultValue("");
+
 }
@@ -0,0 +1,129 @@
+#include "QTRandom.hh"
+
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+// std
+#include <cmath>
+
+namespace {
+  std::uint64_t runSeed = 0; // set on master before workers start
+
+  // per thread and stream: draw block index and unused block words
+  struct StreamState {
+    std::uint32_t                block = 0; // 2^34 words per event and stream
+    std::array<std::uint32_t,4>  words{};
+    G4int                        used  = 4;
+  };
+  G4ThreadLocal G4int       currentRun     = 0;
+  G4ThreadLocal G4int       currentEvent   = 0;
+  G4ThreadLocal G4int       currentSegment = 0;
+  G4ThreadLocal StreamState streams[QTRandom::kNStreams];
+
+  inline void mulhilo(std::uint32_t a, std::uint32_t b,
+		      std::uint32_t& hi, std::uint32_t& lo)
+  {
+    std::uint64_t p = (std::uint64_t)a * b;
+    hi = (std::uint32_t)(p >> 32);
+    lo = (std::uint32_t)p;
+  }
+
+  inline std::uint32_t nextWord(G4int stream)
+  {
+    StreamState& s = streams[stream];
+    if (s.used == 4) {
+      // counter: block index, run, event, stream and segment
+      s.words = QTRandom::Philox({s.block, (std::uint32_t)currentRun,
+				  (std::uint32_t)currentEvent,
+				  (std::uint32_t)stream | ((std::uint32_t)currentSegment << 8)},
+				 {(std::uint32_t)runSeed, (std::uint32_t)(runSeed >> 32)});
+      ++s.block;
+      s.used = 0;
+    }
+    return s.words[s.used++];
+  }
+}
+
+
+std::array<std::uint32_t,4> QTRandom::Philox(std::array<std::uint32_t,4> ctr,
+					     std::array<std::uint32_t,2> key)
+{
+  constexpr std::uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+  constexpr std::uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+  for (G4int round = 0; round < 10; ++round) {
+    std::uint32_t hi0, lo0, hi1, lo1;
+    mulhilo(M0, ctr[0], hi0, lo0);
+    mulhilo(M1, ctr[2], hi1, lo1);
+    ctr = {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+    key[0] += W0;
+    key[1] += W1;
+  }
+  return ctr;
+}
+
+
+void QTRandom::SetSeed(std::uint64_t seed)
+{
+  runSeed = seed;
+}
+
+
+std::uint64_t QTRandom::GetSeed()
+{
+  return runSeed;
+}
+
+
+void QTRandom::BeginEvent(G4int runID, G4int eventID, G4int segment)
+{
+  currentRun     = runID;
+  currentEvent   = eventID;
+  currentSegment = segment;
+  for (auto& s : streams) {
+    s.block = 0;
+    s.used  = 4;
+  }
+}
+
+
+G4int QTRandom::GetEventID()
+{
+  return currentEvent;
+}
+
+
+void QTRandom::SeedEngine()
+{
+  // two positive 31 bit seeds, as used by the Geant4 MT run managers
+  long seeds[3];
+  seeds[0] = (long)(nextWord(kEngine) >> 1) + 1;
+  seeds[1] = (long)(nextWord(kEngine) >> 1) + 1;
+  seeds[2] = 0;
+  G4Random::setTheSeeds(seeds, -1);
+}
+
+
+G4double QTRandom::Flat(G4int stream)
+{
+  // 53 bit mantissa, centred in its interval, never 0 or 1
+  // draws in sequence, the order within one expression is unspecified
+  const std::uint64_t hi = nextWord(stream);
+  const std::uint64_t lo = nextWord(stream);
+  const std::uint64_t x  = (hi << 32) | lo;
+  return ((x >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+
+G4double QTRandom::Gauss(G4int stream, G4double mean, G4double sigma)
+{
+  // Box-Muller, one of the pair; no cached state keeps draws counter-pure
+  G4double u1 = Flat(stream);
+  G4double u2 = Flat(stream);
+  return mean + sigma * std::sqrt(-2.0*std::log(u1)) * std::cos(CLHEP::twopi*u2);
+}
+
+
+QTRandom::Engine::result_type QTRandom::Engine::operator()()
+{
+  return nextWord(fStream);
+}
@@ -1,5 +1,6 @@
 #include "QTRunAction.hh"
 #include "QTOutputManager.hh"
+#include "QTEventCost.hh"
 
 #include "G4Run.hh"
 #include "G4RunManager.hh"
@@ -25,7 +26,7 @@ QTRunAction::~QTRunAction()
   delete fMessenger;
 }
 
-void QTRunAction::BeginOfRunAction(const G4Run* /*run*/)
+void QTRunAction::BeginOfRunAction(const G4Run* run)
 {
   fOutput->Book(); // set up output
 
@@ -35,6 +36,7 @@ void QTRunAction::BeginOfRunAction(const G4Run* /*run*/)
   if (isMaster) {
     fTimer = new G4Timer();
     fTimer->Start();
+    QTEventCost::Instance().BeginRun(run->GetNumberOfEventToBeProcessed()); // event order
   }
 }
 
@@ -44,6 +46,7 @@ void QTRunAction::EndOfRunAction(const G4Run* aRun)
     fTimer->Stop();
     G4cout << "Master thread time: " << *fTimer << G4endl;
     delete fTimer;
+    QTEventCost::Instance().EndRun(); // tail report
   }
 
   G4int nofEvents = aRun->GetNumberOfEvent();
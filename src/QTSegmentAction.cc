@@ -0,0 +1,27 @@
+#include "QTSegmentAction.hh"
+#include "QTSegmentStore.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4EventManager.hh"
+
+
+QTSegmentAction::QTSegmentAction(G4double length)
+  : G4UserSteppingAction()
+  , fLength(length)
+{}
+
+
+void QTSegmentAction::UserSteppingAction(const G4Step* step)
+{
+  G4Track* track = step->GetTrack();
+  if (track->GetTrackID() != 1 || track->GetTrackStatus() != fAlive) return;
+  if (track->GetLocalTime() < fLength) return;
+
+  // local time restarts with each segment, the vertex is the checkpoint
+  auto* segment =
+    dynamic_cast<QTSegmentInfo*>(G4EventManager::GetEventManager()->GetUserInformation());
+  if (!segment) return;
+  segment->Stop(*track);
+  track->SetTrackStatus(fStopAndKill); // secondaries continue in this event
+}
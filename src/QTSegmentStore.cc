@@ -0,0 +1,107 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTSegmentStore
+//
+// Creation date: 2026
+//
+// -------------------------------------------------------------------
+
+#include "QTSegmentStore.hh"
+
+#include <algorithm>
+#include <utility>
+
+#include "G4Track.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+
+
+QTSegmentStore& QTSegmentStore::Instance()
+{
+  static QTSegmentStore store;
+  return store;
+}
+
+
+void QTSegmentStore::Push(const Checkpoint& c)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fCollected.push_back(c);
+}
+
+
+void QTSegmentStore::Hold(G4int eventID, Series& s)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  Series& held = fHeld[eventID];
+  if (held.dcol.empty() && held.icol.empty()) held = std::move(s);
+  else {
+    for (std::size_t c = 0; c < held.dcol.size(); ++c)
+      held.dcol[c].insert(held.dcol[c].end(), s.dcol[c].begin(), s.dcol[c].end());
+    for (std::size_t c = 0; c < held.icol.size(); ++c)
+      held.icol[c].insert(held.icol[c].end(), s.icol[c].begin(), s.icol[c].end());
+  }
+  s = Series();
+}
+
+
+G4bool QTSegmentStore::Release(G4int eventID, Series& s)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  auto it = fHeld.find(eventID);
+  if (it == fHeld.end()) return false;
+  s = std::move(it->second);
+  fHeld.erase(it);
+  return true;
+}
+
+
+G4int QTSegmentStore::NextPass()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fPending.swap(fCollected);
+  fCollected.clear();
+  // event order of the pass independent of the worker finishing order
+  std::sort(fPending.begin(), fPending.end(),
+	    [](const Checkpoint& a, const Checkpoint& b) { return a.eventID < b.eventID; });
+  fPass = fPending.empty() ? 0 : fPass + 1;
+  if (fPass > 0)
+    G4cout << "QTSegmentStore: pass " << fPass << ", " << fPending.size()
+	   << " primaries continued" << G4endl;
+  return (G4int)fPending.size();
+}
+
+
+std::string QTSegmentStore::PassFileName(const std::string& name) const
+{
+  if (fPass == 0) return name;
+  std::string out = name;
+  std::size_t dot = out.rfind('.');
+  if (dot == std::string::npos || out.find('/', dot) != std::string::npos)
+    dot = out.size();
+  out.insert(dot, "_seg" + std::to_string(fPass));
+  return out;
+}
+
+
+void QTSegmentInfo::Print() const
+{
+  G4cout << "Event " << fStart.eventID << " segment " << fStart.segment
+	 << " from t = " << fStart.time/ns << " ns";
+  if (fStopped) G4cout << ", stopped at t = " << fStop.time/ns << " ns";
+  G4cout << G4endl;
+}
+
+
+void QTSegmentInfo::Stop(const G4Track& track)
+{
+  fStop           = fStart;
+  fStop.segment   = fStart.segment + 1;
+  fStop.position  = track.GetPosition();
+  fStop.direction = track.GetMomentumDirection();
+  fStop.ekin      = track.GetKineticEnergy();
+  fStop.time      = track.GetGlobalTime();
+  fStopped        = true;
+}
@@ -30,6 +30,7 @@ QTTrajectory::QTTrajectory(const G4Track* aTrack, std::vector<G4double>& ang)
 , fTrackID(aTrack->GetTrackID())
 , fParentID(aTrack->GetParentID())
 , initialMomentum(aTrack->GetMomentum())
+, fColumns(QTStorePool<QTColumnStore>::Acquire()) // from thread-local pool
 {
   // set up information retrieval from singletons
   pfieldManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
@@ -48,11 +49,7 @@ QTTrajectory::QTTrajectory(const G4Track* aTrack, std::vector<G4double>& ang)
 
 QTTrajectory::~QTTrajectory()
 {
-  fST.clear();
-  fKE.clear();
-  fOm.clear();
-  fVT.clear();
-  fAntennaID.clear();
+  QTStorePool<QTColumnStore>::Release(fColumns); // back to pool, keeps capacity
 }
 
 void QTTrajectory::AppendStep(const G4Step* aStep)
@@ -87,13 +84,13 @@ void QTTrajectory::AppendStep(const G4Step* aStep)
   G4double B[6]; // interface needs array pointers
   pfieldManager->GetDetectorField()->GetFieldValue(pos_, B);
   G4ThreeVector Bfield = G4ThreeVector( B[0], B[1], B[2] ) / tesla; // [Tesla] explicitly
-  fOm.push_back(pEqn->CalcOmegaGivenB(Bfield, beta).mag());
-  fKE.push_back(aStep->GetPostStepPoint()->GetKineticEnergy());
-  fST.push_back(gltime); // [ns] by default
+  fColumns->AppendStep(pEqn->CalcOmegaGivenB(Bfield, beta).mag(),
+		       aStep->GetPostStepPoint()->GetKineticEnergy() / keV,
+		       gltime); // [ns] by default
 
   for (unsigned int i=0;i<fAngles.size();++i) {
-    fAntennaID.push_back((G4int)i);            // which antenna
-    fVT.push_back(convertToVT(i));
+    std::pair<double,double> vt = convertToVT(i);
+    fColumns->AppendSignal((G4int)i, vt.first, vt.second); // which antenna
   }
 }
 
@@ -0,0 +1,111 @@
+#include "QTVertexFile.hh"
+
+#include "G4AutoLock.hh"
+
+// std
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+  G4Mutex myVertexFileLock = G4MUTEX_INITIALIZER;
+
+  struct VertexHeader {
+    char         magic[8];
+    std::int32_t version;
+    std::int32_t ncolumns;
+    std::int64_t nvertices;
+    std::int64_t reserved;
+  };
+  static_assert(sizeof(VertexHeader) == 32, "no padding in vertex header");
+  static_assert(sizeof(QTVertexFile::Vertex) == 9*sizeof(double), "no padding in vertex");
+  constexpr char         vertexMagic[8] = "QTVTX";
+  constexpr std::int32_t vertexVersion  = 1;
+}
+
+
+std::shared_ptr<const QTVertexFile> QTVertexFile::Get(const G4String& fname)
+{
+  // cache holds no ownership, unused files are unmapped
+  static std::map<G4String, std::weak_ptr<const QTVertexFile>> cache;
+
+  G4AutoLock lock(&myVertexFileLock);
+  auto& entry = cache[fname];
+  std::shared_ptr<const QTVertexFile> file = entry.lock();
+  if (!file) {
+    file  = std::shared_ptr<const QTVertexFile>(new QTVertexFile(fname));
+    entry = file;
+  }
+  return file;
+}
+
+
+QTVertexFile::QTVertexFile(const G4String& fname)
+: fName(fname)
+{
+  int fd = open(fname.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(VertexHeader)) {
+    if (fd >= 0) close(fd);
+    G4ExceptionDescription msg;
+    msg << "Cannot read vertex file " << fname << ".";
+    G4Exception("QTVertexFile::QTVertexFile()", "QTVertex001", FatalException, msg);
+    return;
+  }
+  fMapSize = (std::size_t)st.st_size;
+  fMap     = mmap(nullptr, fMapSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (fMap == MAP_FAILED) {
+    fMap = nullptr;
+    G4ExceptionDescription msg;
+    msg << "Cannot map vertex file " << fname << ".";
+    G4Exception("QTVertexFile::QTVertexFile()", "QTVertex001", FatalException, msg);
+    return;
+  }
+
+  VertexHeader h;
+  std::memcpy(&h, fMap, sizeof(h));
+  // file size checked against the count by division, a corrupt count
+  // cannot overflow the product
+  const std::size_t payload = fMapSize - sizeof(VertexHeader);
+  if (std::memcmp(h.magic, vertexMagic, sizeof(h.magic)) != 0 || h.version != vertexVersion
+      || h.ncolumns != 9 || h.nvertices < 0
+      || (std::uint64_t)h.nvertices > payload / sizeof(Vertex)
+      || (std::size_t)h.nvertices * sizeof(Vertex) != payload) {
+    G4ExceptionDescription msg;
+    msg << "Vertex file " << fname << " is not in QTVTX format version "
+	<< vertexVersion << " with 9 columns, or truncated.";
+    G4Exception("QTVertexFile::QTVertexFile()", "QTVertex002", FatalException, msg);
+    return;
+  }
+  fVertices = reinterpret_cast<const Vertex*>(static_cast<const char*>(fMap) + sizeof(VertexHeader));
+  fSize     = (G4long)h.nvertices;
+}
+
+
+QTVertexFile::~QTVertexFile()
+{
+  if (fMap) munmap(fMap, fMapSize);
+}
+
+
+void QTVertexFile::Prefetch(G4long from, G4long n) const
+{
+  from = std::max<G4long>(from, 0);
+  n    = std::min(n, fSize - from);
+  if (n <= 0) return;
+
+  // madvise wants page aligned start
+  static const std::size_t page = (std::size_t)sysconf(_SC_PAGESIZE);
+  std::size_t begin = sizeof(VertexHeader) + (std::size_t)from*sizeof(Vertex);
+  std::size_t end   = begin + (std::size_t)n*sizeof(Vertex);
+  begin -= begin % page;
+  madvise(static_cast<char*>(fMap) + begin, end - begin, MADV_WILLNEED);
+}
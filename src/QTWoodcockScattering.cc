@@ -0,0 +1,161 @@
+// -------------------------------------------------------------------
+//
+// QTNM project
+//
+// File name:     QTWoodcockScattering
+//
+// Creation date: 2026
+//
+// -------------------------------------------------------------------
+
+#include "QTWoodcockScattering.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "G4SystemOfUnits.hh"
+#include "G4EmParameters.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4MaterialCutsCouple.hh"
+#include "G4Material.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4Track.hh"
+#include "G4Log.hh"
+#include "QTRandom.hh"
+
+
+QTWoodcockScattering::QTWoodcockScattering()
+  : G4CoulombScattering()
+{
+  // the rejection against the majorant replaces the integral approach
+  SetCrossSectionType(fEmNoIntegral);
+}
+
+
+void QTWoodcockScattering::BuildPhysicsTable(const G4ParticleDefinition& part)
+{
+  G4CoulombScattering::BuildPhysicsTable(part);
+  build_majorant();
+}
+
+
+void QTWoodcockScattering::build_majorant()
+{
+  G4EmParameters* param = G4EmParameters::Instance();
+  const G4double emin = param->MinKinEnergy();
+  const G4double emax = param->MaxKinEnergy();
+  const G4int    nbin = std::max(1, (G4int)std::ceil(param->NumberOfBinsPerDecade() *
+                                                     std::log10(emax/emin)));
+  fLogEmin  = G4Log(emin);
+  fInvDlogE = nbin / (G4Log(emax) - fLogEmin);
+  fMajorant.clear();
+  fGroup.assign(G4ProductionCutsTable::GetProductionCutsTable()->GetTableSize(), kVacuum);
+
+  // one table per region with more than one non-vacuum couple, maximum
+  // over them, sub-sampled in energy; a single one has nothing to gain
+  // and keeps the exact cross section
+  const G4double dlog = 1.0 / (fInvDlogE * nSubPoints);
+  for (G4Region* region : *G4RegionStore::GetInstance()) {
+    std::vector<const G4MaterialCutsCouple*> couples;
+    auto mat = region->GetMaterialIterator();
+    for (std::size_t m = 0; m < region->GetNumberOfMaterials(); ++m, ++mat) {
+      const G4MaterialCutsCouple* couple = region->FindCouple(*mat);
+      if (!couple || !couple->IsUsed()) continue;
+      if ((*mat)->GetDensity() <= vacuumDensity) continue;
+      couples.push_back(couple);
+    }
+    if (couples.size() == 1) {
+      fGroup[couples[0]->GetIndex()] = kExact;
+      continue;
+    }
+    if (couples.empty()) continue;
+    std::vector<G4double> majorant(nbin, 0.0);
+    for (const G4MaterialCutsCouple* couple : couples) {
+      // exact wherever a couple is alone in some region
+      if (fGroup[couple->GetIndex()] != kExact) fGroup[couple->GetIndex()] = (G4int)fMajorant.size();
+      for (G4int i = 0; i < nbin; ++i) {
+        for (G4int k = 0; k <= nSubPoints; ++k) {
+          const G4double e = std::exp(fLogEmin + (i*nSubPoints + k)*dlog);
+          majorant[i] = std::max(majorant[i], GetCrossSection(e, couple));
+        }
+      }
+    }
+    // energy falls along a step: bin i covers bins i-1 and i
+    for (G4int i = nbin-1; i > 0; --i)
+      majorant[i] = majorantMargin * std::max(majorant[i], majorant[i-1]);
+    majorant[0] *= majorantMargin;
+    fMajorant.push_back(std::move(majorant));
+  }
+}
+
+
+G4double QTWoodcockScattering::Majorant(const G4MaterialCutsCouple* couple,
+                                        G4double logEkin) const
+{
+  const G4int group = fGroup[couple->GetIndex()];
+  if (group < 0) return 0.0; // vacuum or exact
+  const std::vector<G4double>& majorant = fMajorant[group];
+  const G4int nbin = (G4int)majorant.size();
+  const G4int i    = (G4int)((logEkin - fLogEmin) * fInvDlogE);
+  return majorant[std::min(std::max(i, 0), nbin-1)];
+}
+
+
+G4double QTWoodcockScattering::PostStepGetPhysicalInteractionLength(const G4Track& track,
+                                                                    G4double previousStepSize,
+                                                                    G4ForceCondition* condition)
+{
+  // alone in its region: plain process
+  if (fGroup[track.GetMaterialCutsCouple()->GetIndex()] == kExact) {
+    return G4CoulombScattering::PostStepGetPhysicalInteractionLength(track, previousStepSize,
+                                                                     condition);
+  }
+  *condition = NotForced;
+
+  // countdown in majorant interaction lengths, per region; the previous
+  // step is subtracted at the majorant it was proposed with
+  if (theNumberOfInteractionLengthLeft < 0.0) {
+    theNumberOfInteractionLengthLeft    = -G4Log(QTRandom::Flat(QTRandom::kElastic));
+    theInitialNumberOfInteractionLength = theNumberOfInteractionLengthLeft;
+  }
+  else if (previousStepSize > 0.0) {
+    SubtractNumberOfInteractionLengthLeft(previousStepSize);
+  }
+
+  const G4double sigma = Majorant(track.GetMaterialCutsCouple(),
+                                  track.GetDynamicParticle()->GetLogKineticEnergy());
+  currentInteractionLength = (sigma > 0.0) ? 1.0/sigma : DBL_MAX;
+  return (sigma > 0.0) ? theNumberOfInteractionLengthLeft * currentInteractionLength : DBL_MAX;
+}
+
+
+G4VParticleChange* QTWoodcockScattering::PostStepDoIt(const G4Track& track,
+                                                      const G4Step& step)
+{
+  if (fGroup[track.GetMaterialCutsCouple()->GetIndex()] == kExact) {
+    return G4CoulombScattering::PostStepDoIt(track, step);
+  }
+  // true cross section at the tentative collision; also sets up the
+  // couple and model for the real one
+  const G4double sigma = GetCrossSection(track.GetKineticEnergy(),
+                                         track.GetMaterialCutsCouple());
+  const G4double ratio = sigma * currentInteractionLength;
+  if (ratio > 1.0 && !fWarned) {
+    fWarned = true;
+    G4ExceptionDescription ed;
+    ed << "Cross section exceeds the majorant by a factor " << ratio << " at "
+       << track.GetKineticEnergy()/eV << " eV in " << track.GetMaterial()->GetName();
+    G4Exception("QTWoodcockScattering::PostStepDoIt()", "QTWoodcock01",
+                JustWarning, ed);
+  }
+
+  if (ratio < QTRandom::Flat(QTRandom::kElastic)) { // null collision
+    theNumberOfInteractionLengthLeft = -1.0;
+    fParticleChange.InitializeForPostStep(track);
+    fParticleChange.ProposeSteppingControl(AvoidHitInvocation);
+    return &fParticleChange;
+  }
+  return G4CoulombScattering::PostStepDoIt(track, step);
+}
@@ -41,6 +41,7 @@
 #include "DetectorConstruction.hh"
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
+#include "QTNMeImpactIonisation.hh"
 
 #include "CLI11.hpp"
 
@@ -54,15 +55,21 @@ int main(int argc,char** argv) {
   std::string outputFileName("CrossSection.root");
   std::string macroName;
   std::string physListName("ElasticScatteringList");
+  bool        validate = false;
 
   app.add_option("-m,--macro", macroName, "<Geant4 macro filename> Default: None");
   app.add_option("-p,--physlist", physListName, "<Geant4 physics list macro> Default: ElasticScatteringList");
   app.add_option("-s,--seed", seed, "<Geant4 random number seed + offset 1234> Default: 1234");
   app.add_option("-o,--outputFile", outputFileName,
                  "<FULL PATH ROOT FILENAME> Default: CrossSection.root");
+  app.add_option("-v,--validate", validate,
+                 "<Boolean switch, compare ionisation cross section tables to formula> Default: false");
 
   CLI11_PARSE(app, argc, argv);
 
+  // print table deviations from the modified Bell formula at initialisation
+  QTNMeImpactIonisation::SetValidation(validate);
+
   // Get the pointer to the User Interface manager
   //
   G4UImanager *UImanager = G4UImanager::GetUIpointer();
@@ -2,7 +2,7 @@
 
 #include "G4EmBuilder.hh"
 #include "G4EmParameters.hh"
-#include "G4EmMultiModel.hh"
+#include "QTNMMultiModel.hh"
 #include "G4LossTableManager.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4SystemOfUnits.hh"
@@ -111,7 +111,7 @@ void MultipleScatteringList::ConstructProcess() {
   G4CoulombScattering* ss = new G4CoulombScattering();
   ss->SetEmModel(new G4eSingleCoulombScatteringModel()); // high energy
 
-  G4EmMultiModel* mm = new G4EmMultiModel("CoulombSSModels");
+  QTNMMultiModel* mm = new QTNMMultiModel("CoulombSSModels");
   // Elastic Scattering
   mm->AddModel(new QTNMElasticModel());
   // Impact Ionisation
@@ -0,0 +1,153 @@
+// Sampling benchmark for the impact ionisation angular distribution:
+// tabulated QTNMIonisationAngles against the per collision
+// piecewise constant distribution it replaces.
+
+#include "QTNMIonisationAngles.hh"
+
+#include "G4PhysicalConstants.hh"
+
+#include "CLI11.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+  const G4int nAngles = 181;
+
+  // (w, t) of a hydrogen gas run: T log uniform in [20 eV, 18.6 keV],
+  // secondary energy log uniform up to its maximum
+  struct Collision { G4double w, t; };
+
+  std::vector<Collision> makeCollisions(G4int n, std::mt19937_64& rng)
+  {
+    std::uniform_real_distribution<G4double> flat(0.0, 1.0);
+    const G4double bind = 13.6; // eV
+    std::vector<Collision> v(n);
+    for (auto& c : v) {
+      G4double T   = 20.0 * std::exp(flat(rng) * std::log(18.6e3 / 20.0));
+      G4double wmx = 0.5 * (T - bind) / bind;
+      c.t = T / bind;
+      c.w = 1e-3 * std::exp(flat(rng) * std::log(wmx / 1e-3));
+    }
+    return v;
+  }
+
+  // densities before the Lorentzian correction, squared (1 + x) in the
+  // denominator as in the original angle_pdf
+  G4double fbeLegacy(G4double w, G4double t, G4double theta)
+  {
+    G4double G2 = std::sqrt((w+1)/t);
+    G4double G3 = 0.6 * std::sqrt((1 - G2*G2) / w);
+    G4double x  = (std::cos(theta) - G2) / G3;
+    return 1.0 / ((1.0 + x)*(1.0 + x));
+  }
+
+  G4double fbLegacy(G4double w, G4double t, G4double theta)
+  {
+    G4double x = 3.0*(std::cos(theta) + 1.0);
+    return 10.0 * std::pow(1 - w/t, 3) / t / (w + 1) / ((1.0 + x)*(1.0 + x));
+  }
+
+  // normalised per degree CDF and mean angle [deg] of a density
+  template <class F>
+  G4double degreeCdf(const std::vector<G4double>& angle, F density, std::vector<G4double>& cdf)
+  {
+    G4double mean = 0.0;
+    cdf.assign(nAngles, 0.0);
+    for (G4int i = 1; i < nAngles - 1; ++i) {
+      G4double p = density(angle[i]);
+      cdf[i+1] = cdf[i] + p;
+      mean += p * (i + 0.5);
+    }
+    return mean / cdf[nAngles-1];
+  }
+
+  // the former per collision sampling
+  G4double sampleDirect(const Collision& c, std::vector<G4double>& angle,
+			std::vector<G4double>& pdf, std::mt19937_64& rng)
+  {
+    for (G4int i = 1; i < nAngles; i++)
+      pdf[i] = QTNMIonisationAngles::fbe(c.w, c.t, angle[i]) + QTNMIonisationAngles::fb(c.w, c.t, angle[i]);
+    std::piecewise_constant_distribution<> dist(angle.begin(), angle.end(), pdf.begin());
+    return dist(rng);
+  }
+}
+
+
+int main(int argc, char** argv)
+{
+  CLI::App app{ "Ionisation angle sampling benchmark" };
+  int nsamples = 1000000;
+  int ncheck   = 20;
+  app.add_option("-n,--nsamples", nsamples, "<number of collisions timed> Default: 1000000");
+  app.add_option("-c,--ncheck", ncheck, "<number of (w,t) points compared> Default: 20");
+  CLI11_PARSE(app, argc, argv);
+
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<G4double> flat(0.0, 1.0);
+  std::vector<G4double> angle(nAngles), pdf(nAngles, 0.0);
+  for (G4int i = 0; i < nAngles; ++i) angle[i] = i * CLHEP::pi / 180.0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  const QTNMIonisationAngles& table = QTNMIonisationAngles::Instance();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "table build " << std::chrono::duration<double, std::milli>(t1 - t0).count()
+	    << " ms" << std::endl;
+
+  // timing, two samples per collision as in SampleSecondaries
+  std::vector<Collision> coll = makeCollisions(nsamples, rng);
+  G4double sink = 0.0;
+  t0 = std::chrono::steady_clock::now();
+  for (const auto& c : coll) sink += sampleDirect(c, angle, pdf, rng);
+  t1 = std::chrono::steady_clock::now();
+  for (const auto& c : coll) sink += table.SampleTheta(c.w, c.t, flat(rng), flat(rng));
+  auto t2 = std::chrono::steady_clock::now();
+  G4double direct = std::chrono::duration<double, std::micro>(t1 - t0).count() / nsamples;
+  G4double tabled = std::chrono::duration<double, std::micro>(t2 - t1).count() / nsamples;
+  std::cout << "direct " << direct << " us/sample, table " << tabled
+	    << " us/sample, speed-up " << direct / tabled << " (" << sink << ")" << std::endl;
+
+  // agreement: Kolmogorov-Smirnov distance against the exact piecewise CDF
+  const G4int n = 20000;
+  G4double ksmax = 0.0;
+  for (const auto& c : makeCollisions(ncheck, rng)) {
+    std::vector<G4double> cdf(nAngles, 0.0);
+    for (G4int i = 1; i < nAngles - 1; ++i)
+      cdf[i+1] = cdf[i] + QTNMIonisationAngles::fbe(c.w, c.t, angle[i]) + QTNMIonisationAngles::fb(c.w, c.t, angle[i]);
+    for (auto& x : cdf) x /= cdf[nAngles-1];
+
+    std::vector<G4double> theta(n);
+    for (auto& th : theta) th = table.SampleTheta(c.w, c.t, flat(rng), flat(rng)) * 180.0 / CLHEP::pi;
+    std::sort(theta.begin(), theta.end());
+    G4double ks = 0.0;
+    for (G4int k = 0; k < n; ++k) {
+      G4int    i = std::min((G4int)theta[k], nAngles - 2);
+      G4double F = cdf[i] + (theta[k] - i) * (cdf[i+1] - cdf[i]);
+      ks = std::max(ks, std::fabs(F - (k + 0.5) / n));
+    }
+    ksmax = std::max(ksmax, ks);
+  }
+  std::cout << "max KS distance " << ksmax << " over " << ncheck << " (w,t) points, "
+	    << "statistical 95% level " << 1.36 / std::sqrt((G4double)n) << std::endl;
+
+  // before/after the Lorentzian correction: exact per degree CDFs
+  std::cout << "legacy vs Lorentzian: T [eV], w, mean angle [deg] legacy, corrected, KS distance" << std::endl;
+  G4double ksdiff = 0.0;
+  for (const auto& c : makeCollisions(ncheck, rng)) {
+    std::vector<G4double> cdfOld, cdfNew;
+    G4double meanOld = degreeCdf(angle, [&c](G4double th) { return fbeLegacy(c.w, c.t, th) + fbLegacy(c.w, c.t, th); }, cdfOld);
+    G4double meanNew = degreeCdf(angle, [&c](G4double th) {
+	return QTNMIonisationAngles::fbe(c.w, c.t, th) + QTNMIonisationAngles::fb(c.w, c.t, th); }, cdfNew);
+    G4double ks = 0.0;
+    for (G4int i = 0; i < nAngles; ++i)
+      ks = std::max(ks, std::fabs(cdfOld[i]/cdfOld[nAngles-1] - cdfNew[i]/cdfNew[nAngles-1]));
+    ksdiff = std::max(ksdiff, ks);
+    std::cout << "  " << c.t * 13.6 << " " << c.w << " " << meanOld << " " << meanNew << " " << ks << std::endl;
+  }
+  std::cout << "max KS distance legacy vs Lorentzian " << ksdiff << std::endl;
+  return 0;
+}
@@ -0,0 +1,175 @@
+// Physics list benchmark for trapped electrons: time to first event and
+// per step cost of a physics constructor, e.g. QTNMPhysicsList against
+// QTNMTrapPhysics, for 18.6 keV electrons circling in a uniform magnetic
+// field inside a dilute T2 gas volume.
+
+#include "G4RunManagerFactory.hh"
+#include "G4UImanager.hh"
+#include "G4GenericPhysicsList.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VUserDetectorConstruction.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "G4UserEventAction.hh"
+#include "G4UserSteppingAction.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4NistManager.hh"
+#include "G4Element.hh"
+#include "G4Material.hh"
+#include "G4UniformMagField.hh"
+#include "G4FieldManager.hh"
+#include "G4TransportationManager.hh"
+#include "G4ParticleGun.hh"
+#include "G4Electron.hh"
+#include "G4Event.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4SystemOfUnits.hh"
+
+#include "CLI11.hpp"
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  class Detector : public G4VUserDetectorConstruction
+  {
+  public:
+    Detector(G4double density, G4double field) : fDensity(density), fField(field) {}
+
+    G4VPhysicalVolume* Construct() override
+    {
+      G4Material* vacuum = G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+      G4Element*  T      = new G4Element("Tritium", "T", 1., 3.016 * g / mole);
+      G4Material* gas    = new G4Material("TritiumGas", fDensity, 1);
+      gas->AddElement(T, 1);
+
+      auto* worldS  = new G4Box("World", 1*m, 1*m, 1*m);
+      auto* worldLV = new G4LogicalVolume(worldS, vacuum, "World");
+      auto* worldPV = new G4PVPlacement(nullptr, G4ThreeVector(), worldLV, "World",
+                                        nullptr, false, 0);
+      auto* gasS  = new G4Box("Gas", 20*cm, 20*cm, 20*cm);
+      auto* gasLV = new G4LogicalVolume(gasS, gas, "Gas");
+      new G4PVPlacement(nullptr, G4ThreeVector(), gasLV, "Gas", worldLV, false, 0);
+
+      auto* field = new G4UniformMagField(G4ThreeVector(0., 0., fField));
+      G4FieldManager* fm = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+      fm->SetDetectorField(field);
+      fm->CreateChordFinder(field);
+      return worldPV;
+    }
+
+  private:
+    G4double fDensity;
+    G4double fField;
+  };
+
+  // 18.6 keV e- at 90 degree pitch, trapped radially
+  class Primary : public G4VUserPrimaryGeneratorAction
+  {
+  public:
+    Primary() : fGun(1)
+    {
+      fGun.SetParticleDefinition(G4Electron::Electron());
+      fGun.SetParticleEnergy(18.6*keV);
+      fGun.SetParticlePosition(G4ThreeVector());
+      fGun.SetParticleMomentumDirection(G4ThreeVector(1., 0., 0.));
+    }
+    void GeneratePrimaries(G4Event* event) override { fGun.GeneratePrimaryVertex(event); }
+
+  private:
+    G4ParticleGun fGun;
+  };
+
+  struct Counters {
+    G4long             steps = 0;
+    G4bool             first = true;
+    Clock::time_point  firstEvent;
+  };
+
+  class EventAction : public G4UserEventAction
+  {
+  public:
+    explicit EventAction(Counters& c) : fCounters(c) {}
+    void BeginOfEventAction(const G4Event*) override
+    {
+      if (fCounters.first) fCounters.firstEvent = Clock::now();
+      fCounters.first = false;
+    }
+
+  private:
+    Counters& fCounters;
+  };
+
+  // counts steps, ends tracks after the maximum time
+  class SteppingAction : public G4UserSteppingAction
+  {
+  public:
+    SteppingAction(Counters& c, G4double tmax) : fCounters(c), fMaxTime(tmax) {}
+    void UserSteppingAction(const G4Step* step) override
+    {
+      ++fCounters.steps;
+      G4Track* track = step->GetTrack();
+      if (track->GetGlobalTime() > fMaxTime) track->SetTrackStatus(fStopAndKill);
+    }
+
+  private:
+    Counters& fCounters;
+    G4double  fMaxTime;
+  };
+}
+
+
+int main(int argc, char** argv)
+{
+  CLI::App app{ "Physics list benchmark for trapped electrons" };
+  std::string physListName("QTNMTrapPhysics");
+  int         nevents = 100;
+  double      maxtime = 100.0;  // [ns]
+  double      density = 5e-12;  // [g/cm3]
+  double      bfield  = 1.0;    // [T]
+  bool        woodcock = false;
+  app.add_option("-p,--physlist", physListName, "<physics constructor name> Default: QTNMTrapPhysics");
+  app.add_option("-n,--nevents", nevents, "<number of events timed> Default: 100");
+  app.add_option("-t,--maxtime", maxtime, "<track time limit [ns]> Default: 100");
+  app.add_option("-d,--density", density, "<T2 gas density [g/cm3]> Default: 5e-12");
+  app.add_option("-b,--field", bfield, "<magnetic field along z [T]> Default: 1");
+  app.add_flag("-w,--woodcock", woodcock, "Woodcock tracking for e- Coulomb scattering");
+  CLI11_PARSE(app, argc, argv);
+
+  auto t0 = Clock::now();
+  auto* runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::SerialOnly);
+  runManager->SetUserInitialization(new Detector(density*g/cm3, bfield*tesla));
+  auto* constructors = new std::vector<G4String>;
+  constructors->push_back(physListName);
+  runManager->SetUserInitialization(new G4GenericPhysicsList(constructors));
+  if (woodcock) G4UImanager::GetUIpointer()->ApplyCommand("/QT/physics/woodcock true");
+
+  Counters counters;
+  runManager->SetUserAction(new Primary());
+  runManager->SetUserAction(new EventAction(counters));
+  runManager->SetUserAction(new SteppingAction(counters, maxtime*ns));
+
+  // geometry, processes; physics tables are built at the first run
+  runManager->Initialize();
+  auto t1 = Clock::now();
+  runManager->BeamOn(1);
+  auto t2 = Clock::now();
+
+  counters.steps = 0;
+  runManager->BeamOn(nevents);
+  auto t3 = Clock::now();
+
+  auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+  std::cout << physListName << ": initialise " << ms(t1 - t0) << " ms, first event after "
+            << ms(counters.firstEvent - t0) << " ms (first run " << ms(t2 - t1) << " ms)" << std::endl;
+  std::cout << physListName << ": " << counters.steps << " steps in " << nevents << " events, "
+            << 1e6 * ms(t3 - t2) / std::max<G4long>(counters.steps, 1) << " ns/step" << std::endl;
+
+  delete runManager;
+  return 0;
+}
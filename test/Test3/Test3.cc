@@ -0,0 +1,152 @@
+// Fast vacuum transport check: a trapped electron tracked for a fixed
+// time with QTFastTransport against the QTBorisDriver field propagation,
+// same field and start, reporting the end position and energy and the
+// wall time per step.
+
+#include "G4RunManagerFactory.hh"
+#include "G4GenericPhysicsList.hh"
+#include "G4VUserDetectorConstruction.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "G4UserSteppingAction.hh"
+
+#include "G4AutoDelete.hh"
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4NistManager.hh"
+#include "G4ParticleGun.hh"
+#include "G4Electron.hh"
+#include "G4Event.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include "QTMagneticFieldSetup.hh"
+#include "QTFastTransportPhysics.hh"
+
+#include "CLI11.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  // vacuum box in a uniform field along z, QTBorisDriver as in qtnmSim
+  class Detector : public G4VUserDetectorConstruction
+  {
+  public:
+    explicit Detector(G4double field) : fField(field) {}
+
+    G4VPhysicalVolume* Construct() override
+    {
+      G4Material* vacuum = G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+      auto* worldS  = new G4Box("World", 1*m, 1*m, 1*m);
+      auto* worldLV = new G4LogicalVolume(worldS, vacuum, "World");
+      return new G4PVPlacement(nullptr, G4ThreeVector(), worldLV, "World",
+                               nullptr, false, 0);
+    }
+
+    void ConstructSDandField() override
+    {
+      if (fSetup) return;
+      fSetup = new QTMagneticFieldSetup(G4ThreeVector(0., 0., fField));
+      G4AutoDelete::Register(fSetup);
+    }
+
+  private:
+    G4double              fField;
+    QTMagneticFieldSetup* fSetup = nullptr;
+  };
+
+  // 18.6 keV e- at the given pitch angle to the field
+  class Primary : public G4VUserPrimaryGeneratorAction
+  {
+  public:
+    explicit Primary(G4double pitch) : fGun(1)
+    {
+      fGun.SetParticleDefinition(G4Electron::Electron());
+      fGun.SetParticleEnergy(18.6*keV);
+      fGun.SetParticlePosition(G4ThreeVector());
+      fGun.SetParticleMomentumDirection(G4ThreeVector(std::sin(pitch), 0., std::cos(pitch)));
+    }
+    void GeneratePrimaries(G4Event* event) override { fGun.GeneratePrimaryVertex(event); }
+
+  private:
+    G4ParticleGun fGun;
+  };
+
+  struct Result {
+    G4long        steps = 0;
+    G4ThreeVector position;
+    G4double      energy = 0.0;
+  };
+
+  // counts steps, ends the primary after the maximum time
+  class SteppingAction : public G4UserSteppingAction
+  {
+  public:
+    SteppingAction(Result& r, G4double tmax) : fResult(r), fMaxTime(tmax) {}
+    void UserSteppingAction(const G4Step* step) override
+    {
+      G4Track* track = step->GetTrack();
+      if (track->GetTrackID() != 1) return;
+      ++fResult.steps;
+      fResult.position = track->GetPosition();
+      fResult.energy   = track->GetKineticEnergy();
+      if (track->GetGlobalTime() > fMaxTime) track->SetTrackStatus(fStopAndKill);
+    }
+
+  private:
+    Result&  fResult;
+    G4double fMaxTime;
+  };
+}
+
+
+int main(int argc, char** argv)
+{
+  CLI::App app{ "Fast vacuum transport against QTBorisDriver" };
+  bool   fast    = false;
+  double maxtime = 1000.0; // [ns]
+  double bfield  = 1.0;    // [T]
+  double pitch   = 89.0;   // [deg]
+  long   seed    = 1234;
+  app.add_flag("-f,--fast-transport", fast, "QTFastTransport for the primary");
+  app.add_option("-t,--maxtime", maxtime, "<track time [ns]> Default: 1000");
+  app.add_option("-b,--field", bfield, "<magnetic field along z [T]> Default: 1");
+  app.add_option("-a,--pitch", pitch, "<pitch angle [deg]> Default: 89");
+  app.add_option("-s,--seed", seed, "<random seed> Default: 1234");
+  CLI11_PARSE(app, argc, argv);
+
+  G4Random::setTheSeed(seed);
+  auto* runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::SerialOnly);
+  runManager->SetUserInitialization(new Detector(bfield*tesla));
+  auto* constructors = new std::vector<G4String>;
+  constructors->push_back("QTNMTrapPhysics");
+  auto* physList = new G4GenericPhysicsList(constructors);
+  if (fast) physList->RegisterPhysics(new QTFastTransportPhysics());
+  runManager->SetUserInitialization(physList);
+
+  Result result;
+  runManager->SetUserAction(new Primary(pitch*deg));
+  runManager->SetUserAction(new SteppingAction(result, maxtime*ns));
+  runManager->Initialize();
+
+  auto t0 = Clock::now();
+  runManager->BeamOn(1);
+  auto t1 = Clock::now();
+
+  const G4String name = fast ? "QTFastTransport" : "QTBorisDriver";
+  const G4double ns_total = std::chrono::duration<double, std::nano>(t1 - t0).count();
+  std::cout << std::setprecision(10)
+            << name << ": end position [mm] " << result.position / mm
+            << ", energy " << result.energy / eV << " eV after " << maxtime << " ns" << std::endl;
+  std::cout << name << ": " << result.steps << " steps, "
+            << ns_total / std::max<G4long>(result.steps, 1) << " ns/step" << std::endl;
+
+  delete runManager;
+  return 0;
+}